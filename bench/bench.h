@@ -0,0 +1,36 @@
+#ifndef GEOM_BENCH_H
+#define GEOM_BENCH_H
+
+#include <chrono>
+
+namespace Bench {
+    class Timer {
+    private:
+        std::chrono::steady_clock::time_point _start;
+    public:
+        Timer() : _start(std::chrono::steady_clock::now()) {}
+
+        void reset() {
+            _start = std::chrono::steady_clock::now();
+        }
+
+        double seconds() const {
+            return std::chrono::duration<double>(std::chrono::steady_clock::now() - _start).count();
+        }
+    };
+
+    int edits(int argc, char **argv);
+    int incremental(int argc, char **argv);
+    int input(int argc, char **argv);
+    int status(int argc, char **argv);
+    int prefilter(int argc, char **argv);
+    int raycast(int argc, char **argv);
+    int suite(int argc, char **argv);
+    int trapezoids(int argc, char **argv);
+    int vertices(int argc, char **argv);
+    int wedges(int argc, char **argv);
+    int zones(int argc, char **argv);
+}
+
+
+#endif //GEOM_BENCH_H
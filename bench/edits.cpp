@@ -0,0 +1,58 @@
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "bench.h"
+#include "belonging.h"
+#include "generators.h"
+
+// Moves single vertices of a large polygon along their rays from the centre
+// and compares the localized re-sweep with rebuilding the engine from scratch.
+int Bench::edits(int argc, char **argv) {
+    size_t n = (argc >= 1 ? std::atol(argv[0]) : 100000);
+    size_t m = (argc >= 2 ? std::atol(argv[1]) : 1000000);
+    size_t moves = (argc >= 3 ? std::atol(argv[2]) : 100);
+    const double radius = 1e6;
+    std::mt19937_64 rng(22);
+
+    std::vector<Bench::Point> polygon = Bench::convex(n, radius, rng);
+    std::vector<Bench::Point> queries = Bench::uniform(m, polygon, rng);
+    std::cout << "edits n=" << polygon.size() << " m=" << m << " moves=" << moves << '\n';
+
+    MultiBelongingAlgorithm<Bench::Point> algorithm(polygon, queries);
+    algorithm.setOrder();
+    algorithm.setEdges();
+    algorithm.setEvents();
+    algorithm.sortEvents();
+    algorithm.run();
+
+    std::uniform_real_distribution<double> scale(0.5, 1.0);
+    Bench::Timer timer;
+    for (size_t k = 0; k < moves; ++k) {
+        size_t i = rng() % polygon.size();
+        const Bench::Point &p = algorithm.polygon().getPoints()[i];
+        double s = scale(rng);
+        algorithm.moveVertex(i, Bench::Point(std::round(p.getX() * s), std::round(p.getY() * s), p.getId()));
+    }
+    double local = timer.seconds() / moves;
+
+    timer.reset();
+    MultiBelongingAlgorithm<Bench::Point> fresh(algorithm.polygon().getPoints(), queries);
+    fresh.setOrder();
+    fresh.setEdges();
+    fresh.setEvents();
+    fresh.sortEvents();
+    fresh.run();
+    double rebuild = timer.seconds();
+
+    std::cout << "  localized: " << local << " s per move\n"
+              << "  rebuild  : " << rebuild << " s per move, speedup " << rebuild / local << '\n';
+
+    if (algorithm.ans() != fresh.ans()) {
+        std::cerr << "edits: answers differ\n";
+        return 1;
+    }
+    return 0;
+}
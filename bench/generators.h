@@ -0,0 +1,176 @@
+#ifndef GEOM_BENCH_GENERATORS_H
+#define GEOM_BENCH_GENERATORS_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "geometry.h"
+
+namespace Bench {
+    using Point = Geometry::Point<double>;
+
+    inline void number(std::vector<Point> &points) {
+        for (size_t i = 0; i < points.size(); ++i)
+            points[i].setId(i);
+    }
+
+    // n vertices on a circle of the given radius, rounded to the integer grid.
+    inline std::vector<Point> convex(size_t n, double radius, std::mt19937_64 &rng) {
+        std::uniform_real_distribution<double> angle(0, 2 * M_PI);
+        std::vector<double> angles(n);
+        for (double &a : angles)
+            a = angle(rng);
+        std::sort(angles.begin(), angles.end());
+
+        std::vector<Point> points;
+        for (double a : angles) {
+            Point p(std::round(radius * std::cos(a)), std::round(radius * std::sin(a)), 0);
+            if (points.empty() || !(points.back() == p))
+                points.push_back(p);
+        }
+        while (points.size() > 1 && points.back() == points.front())
+            points.pop_back();
+        number(points);
+        return points;
+    }
+
+    // Horizontal teeth of random length hanging off a vertical spine: every tooth
+    // keeps two edges open across most of the x-range, so the sweep status holds
+    // about n / 2 edges at once.
+    inline std::vector<Point> comb(size_t n, double width, std::mt19937_64 &rng) {
+        std::uniform_real_distribution<double> length(2, width);
+        size_t teeth = std::max<size_t>(n / 4, 2);
+
+        std::vector<Point> points;
+        points.emplace_back(0, 0, 0);
+        for (size_t i = 0; i < teeth; ++i) {
+            double w = std::round(length(rng));
+            if (i > 0)
+                points.emplace_back(1, 2 * i, 0);
+            points.emplace_back(w, 2 * i, 0);
+            points.emplace_back(w, 2 * i + 1, 0);
+            if (i + 1 < teeth)
+                points.emplace_back(1, 2 * i + 1, 0);
+        }
+        points.emplace_back(0, 2 * teeth - 1, 0);
+        number(points);
+        return points;
+    }
+
+    // Star-shaped around the origin: sorted random angles with random radii.
+    inline std::vector<Point> star(size_t n, double radius, std::mt19937_64 &rng) {
+        std::uniform_real_distribution<double> angle(0, 2 * M_PI), scale(0.3, 1);
+        std::vector<double> angles(n);
+        for (double &a : angles)
+            a = angle(rng);
+        std::sort(angles.begin(), angles.end());
+
+        std::vector<Point> points;
+        for (double a : angles) {
+            double r = radius * scale(rng);
+            Point p(std::round(r * std::cos(a)), std::round(r * std::sin(a)), 0);
+            if (points.empty() || !(points.back() == p))
+                points.push_back(p);
+        }
+        while (points.size() > 1 && points.back() == points.front())
+            points.pop_back();
+        number(points);
+        return points;
+    }
+
+    // A rectilinear skyline over a flat base: half of the edges are vertical,
+    // which exercises the separate vertical-edge pass of the sweep.
+    inline std::vector<Point> skyline(size_t n, double height, std::mt19937_64 &rng) {
+        std::uniform_int_distribution<long long> step(1, 16), level(1, height);
+        size_t columns = std::max<size_t>(n / 2, 2) - 1;
+
+        std::vector<Point> points;
+        double x = 0, previous = -1;
+        points.emplace_back(0, 0, 0);
+        for (size_t i = 0; i < columns; ++i) {
+            double h = level(rng);
+            if (h == previous)
+                h = (h == height ? h - 1 : h + 1);
+            points.emplace_back(x, h, 0);
+            x += step(rng);
+            points.emplace_back(x, h, 0);
+            previous = h;
+        }
+        points.emplace_back(x, 0, 0);
+        number(points);
+        return points;
+    }
+
+    struct Box {
+        double min_x, max_x, min_y, max_y;
+    };
+
+    inline Box bounds(const std::vector<Point> &polygon) {
+        Box box{polygon[0].getX(), polygon[0].getX(), polygon[0].getY(), polygon[0].getY()};
+        for (const Point &p : polygon) {
+            box.min_x = std::min(box.min_x, p.getX());
+            box.max_x = std::max(box.max_x, p.getX());
+            box.min_y = std::min(box.min_y, p.getY());
+            box.max_y = std::max(box.max_y, p.getY());
+        }
+        return box;
+    }
+
+    inline std::vector<Point> uniform(size_t m, const std::vector<Point> &polygon, std::mt19937_64 &rng) {
+        Box box = bounds(polygon);
+        std::uniform_int_distribution<long long> x(box.min_x - 1, box.max_x + 1), y(box.min_y - 1, box.max_y + 1);
+        std::vector<Point> queries;
+        queries.reserve(m);
+        for (size_t i = 0; i < m; ++i)
+            queries.emplace_back(x(rng), y(rng), i);
+        return queries;
+    }
+
+    // Gaussian clouds around a few random centres of the bounding box.
+    inline std::vector<Point> clustered(size_t m, const std::vector<Point> &polygon, std::mt19937_64 &rng) {
+        Box box = bounds(polygon);
+        std::uniform_real_distribution<double> x(box.min_x, box.max_x), y(box.min_y, box.max_y);
+        std::normal_distribution<double> spread(0, std::max(box.max_x - box.min_x, box.max_y - box.min_y) / 100);
+
+        std::vector<Point> centres;
+        for (size_t i = 0; i < 8; ++i)
+            centres.emplace_back(x(rng), y(rng), 0);
+
+        std::vector<Point> queries;
+        queries.reserve(m);
+        for (size_t i = 0; i < m; ++i) {
+            const Point &c = centres[i % centres.size()];
+            queries.emplace_back(std::round(c.getX() + spread(rng)), std::round(c.getY() + spread(rng)), i);
+        }
+        return queries;
+    }
+
+    // Exact lattice points of the polygon edges (vertices included), the worst
+    // case for the border checks.
+    inline std::vector<Point> border(size_t m, const std::vector<Point> &polygon, std::mt19937_64 &rng) {
+        std::uniform_int_distribution<size_t> edge(0, polygon.size() - 1);
+        std::vector<Point> queries;
+        queries.reserve(m);
+        for (size_t i = 0; i < m; ++i) {
+            size_t e = edge(rng);
+            const Point &a = polygon[e], &b = polygon[e + 1 == polygon.size() ? 0 : e + 1];
+
+            long long dx = b.getX() - a.getX(), dy = b.getY() - a.getY();
+            long long g = std::abs(dx), r = std::abs(dy);
+            while (r != 0) {
+                long long t = g % r;
+                g = r;
+                r = t;
+            }
+            long long k = (g > 0 ? std::uniform_int_distribution<long long>(0, g - 1)(rng) : 0);
+            queries.emplace_back(a.getX() + (g ? dx / g * k : 0), a.getY() + (g ? dy / g * k : 0), i);
+        }
+        return queries;
+    }
+}
+
+
+#endif //GEOM_BENCH_GENERATORS_H
@@ -0,0 +1,71 @@
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "bench.h"
+#include "belonging.h"
+#include "generators.h"
+
+// Moves k of m queries per round (erase one, insert a new one) and compares
+// update() with a full sweep of the live queries, checking that they agree.
+int Bench::incremental(int argc, char **argv) {
+    size_t n = (argc >= 1 ? std::atol(argv[0]) : 100000);
+    size_t m = (argc >= 2 ? std::atol(argv[1]) : 1000000);
+    size_t k = (argc >= 3 ? std::atol(argv[2]) : 1000);
+    size_t rounds = (argc >= 4 ? std::atol(argv[3]) : 20);
+    std::mt19937_64 rng(21);
+
+    std::vector<Bench::Point> polygon = Bench::comb(n, 1e6, rng);
+    std::vector<Bench::Point> queries = Bench::uniform(m, polygon, rng);
+    std::cout << "incremental n=" << polygon.size() << " m=" << m << " k=" << k << " rounds=" << rounds << '\n';
+
+    MultiBelongingAlgorithm<Bench::Point> algorithm(polygon, queries);
+    algorithm.setOrder();
+    algorithm.setEdges();
+    algorithm.setEvents();
+    algorithm.sortEvents();
+    algorithm.run();
+
+    std::vector<size_t> live(m);
+    for (size_t i = 0; i < m; ++i)
+        live[i] = i;
+
+    double updates = 0, sweeps = 0;
+    for (size_t round = 0; round < rounds; ++round) {
+        std::vector<Bench::Point> moved = Bench::uniform(k, polygon, rng);
+        Bench::Timer timer;
+        for (const Bench::Point &p : moved) {
+            size_t slot = rng() % live.size();
+            algorithm.erase_query(live[slot]);
+            live[slot] = algorithm.insert_query(p);
+        }
+        algorithm.update();
+        updates += timer.seconds();
+
+        std::vector<Bench::Point> current;
+        for (size_t id : live)
+            current.push_back(algorithm.query(id));
+        Bench::number(current);
+
+        timer.reset();
+        MultiBelongingAlgorithm<Bench::Point> fresh(polygon, current);
+        fresh.setOrder();
+        fresh.setEdges();
+        fresh.setEvents();
+        fresh.sortEvents();
+        fresh.run();
+        sweeps += timer.seconds();
+
+        for (size_t i = 0; i < live.size(); ++i) {
+            if (algorithm.ans()[live[i]] != fresh.ans()[i]) {
+                std::cerr << "incremental: answers differ\n";
+                return 1;
+            }
+        }
+    }
+
+    std::cout << "  update    : " << updates / rounds << " s per round\n"
+              << "  full sweep: " << sweeps / rounds << " s per round, speedup " << sweeps / updates << '\n';
+    return 0;
+}
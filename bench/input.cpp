@@ -0,0 +1,93 @@
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include "bench.h"
+#include "geometry.h"
+#include "scanner.h"
+
+namespace {
+    using Point = Geometry::Point<double>;
+
+    struct Parsed {
+        size_t points = 0;
+        double checksum = 0;
+    };
+
+    template <class Stream>
+    void read_block(Stream &is, std::vector<Point> &points, Parsed &parsed) {
+        size_t size = 0;
+        is >> size;
+        points.resize(size);
+        for (size_t i = 0; i < size; ++i) {
+            is >> points[i];
+            points[i].setId(i);
+            parsed.checksum += points[i].getX() - points[i].getY();
+        }
+        parsed.points += size;
+    }
+
+    // Mirrors what Test::Input/Test::Query do for every test in the file.
+    template <class Stream>
+    Parsed parse(Stream &is) {
+        Parsed parsed;
+        uint32_t tests = 0;
+        is >> tests;
+
+        std::vector<Point> polygon, queries;
+        for (uint32_t i = 0; i < tests; ++i) {
+            read_block(is, polygon, parsed);
+            read_block(is, queries, parsed);
+        }
+        return parsed;
+    }
+
+    void report(const char *name, double seconds, const Parsed &parsed, size_t bytes) {
+        std::cout << name << ": " << seconds << " s, "
+                  << parsed.points / seconds / 1e6 << " Mpoints/s, "
+                  << bytes / seconds / (1 << 20) << " MiB/s, checksum " << parsed.checksum << '\n';
+    }
+}
+
+int Bench::input(int argc, char **argv) {
+    if (argc < 1) {
+        std::cerr << "input: missing file\n";
+        return 1;
+    }
+
+    int repeat = (argc >= 2 ? std::atoi(argv[1]) : 3);
+    int fd = open(argv[0], O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "input: cannot open " << argv[0] << '\n';
+        return 1;
+    }
+
+    IO::MappedFile file(fd);
+    close(fd);
+    if (!file.isMapped()) {
+        std::cerr << "input: " << argv[0] << " is not a regular file\n";
+        return 1;
+    }
+
+    for (int r = 0; r < repeat; ++r) {
+        Timer timer;
+        std::ifstream in(argv[0]);
+        Parsed stream = parse(in);
+        report("istream", timer.seconds(), stream, file.size());
+
+        timer.reset();
+        IO::Scanner scanner(file.begin(), file.end());
+        Parsed mapped = parse(scanner);
+        report("mmap   ", timer.seconds(), mapped, file.size());
+
+        if (stream.points != mapped.points || stream.checksum != mapped.checksum) {
+            std::cerr << "input: parsers disagree\n";
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,38 @@
+#include <cstring>
+#include <iostream>
+
+#include "bench.h"
+
+struct Command {
+    const char *name;
+    const char *usage;
+    int (*run)(int argc, char **argv);
+};
+
+static const Command commands[] = {
+        {"edits", "edits [vertices] [queries] [moves]", Bench::edits},
+        {"incremental", "incremental [vertices] [queries] [changes] [rounds]", Bench::incremental},
+        {"input", "input <file> [repeat]", Bench::input},
+        {"status", "status [vertices] [queries]", Bench::status},
+        {"prefilter", "prefilter [vertices] [queries] [cells]", Bench::prefilter},
+        {"raycast", "raycast", Bench::raycast},
+        {"suite", "suite [vertices] [queries] [shape]", Bench::suite},
+        {"trapezoids", "trapezoids [vertices] [queries]", Bench::trapezoids},
+        {"vertices", "vertices [vertices] [queries]", Bench::vertices},
+        {"wedges", "wedges [vertices] [queries]", Bench::wedges},
+        {"zones", "zones [polygons] [vertices] [queries]", Bench::zones},
+};
+
+int main(int argc, char **argv) {
+    if (argc >= 2) {
+        for (const Command &c : commands) {
+            if (std::strcmp(argv[1], c.name) == 0)
+                return c.run(argc - 2, argv + 2);
+        }
+    }
+
+    std::cerr << "usage:\n";
+    for (const Command &c : commands)
+        std::cerr << "  geom_bench " << c.usage << '\n';
+    return 1;
+}
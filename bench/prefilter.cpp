@@ -0,0 +1,56 @@
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "bench.h"
+#include "belonging.h"
+#include "generators.h"
+
+namespace {
+    Geometry::Answers measure(const char *name, size_t cells, const std::vector<Bench::Point> &polygon,
+                              const std::vector<Bench::Point> &queries) {
+        Bench::Timer timer;
+        MultiBelongingAlgorithm<Bench::Point> algorithm(polygon, queries);
+        algorithm.setGrid(cells);
+        algorithm.setOrder();
+        algorithm.setEdges();
+        algorithm.setEvents();
+        algorithm.sortEvents();
+        algorithm.run();
+        std::cout << "  " << name << ": " << timer.seconds() << " s\n";
+        return algorithm.take_ans();
+    }
+
+    bool compare(const char *name, size_t cells, const std::vector<Bench::Point> &polygon,
+                 const std::vector<Bench::Point> &queries) {
+        std::cout << name << '\n';
+        Geometry::Answers box = measure("box ", 0, polygon, queries);
+        Geometry::Answers grid = measure("grid", cells, polygon, queries);
+        if (box != grid) {
+            std::cerr << "prefilter: answers differ\n";
+            return false;
+        }
+        return true;
+    }
+}
+
+// A convex polygon with queries over its bounding box, where the grid settles
+// the cells clear of the boundary, and over a square ten times its size in one
+// corner of which it sits, where the bounding box alone settles most of them.
+int Bench::prefilter(int argc, char **argv) {
+    size_t n = (argc >= 1 ? std::atol(argv[0]) : 20000);
+    size_t m = (argc >= 2 ? std::atol(argv[1]) : 2000000);
+    size_t cells = (argc >= 3 ? std::atol(argv[2]) : 256);
+    const double radius = 1e6;
+    std::mt19937_64 rng(23);
+
+    std::vector<Bench::Point> polygon = Bench::convex(n, radius, rng);
+    std::vector<Bench::Point> square = {Bench::Point(-radius, -radius, 0), Bench::Point(9 * radius, -radius, 1),
+                                        Bench::Point(9 * radius, 9 * radius, 2), Bench::Point(-radius, 9 * radius, 3)};
+    std::cout << "prefilter n=" << polygon.size() << " m=" << m << " cells=" << cells << '\n';
+
+    bool ok = compare("bounding box", cells, polygon, Bench::uniform(m, polygon, rng));
+    ok &= compare("large square", cells, polygon, Bench::uniform(m, square, rng));
+    return ok ? 0 : 1;
+}
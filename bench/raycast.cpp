@@ -0,0 +1,78 @@
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "bench.h"
+#include "belonging.h"
+#include "generators.h"
+#include "ray_casting.h"
+
+namespace {
+    // Repeats the body until at least 50 ms have elapsed and returns seconds per call.
+    template <class Body>
+    double per_call(Body body) {
+        size_t calls = 0;
+        Bench::Timer timer;
+        do {
+            body();
+            calls++;
+        } while (timer.seconds() < 0.05);
+        return timer.seconds() / calls;
+    }
+}
+
+int Bench::raycast(int, char **) {
+    std::mt19937_64 rng(7);
+    const size_t sizes[] = {4, 16, 64, 256, 512, 1024, 2048};
+    const size_t batches[] = {16, 256, 4096, 65536};
+
+    std::cout << "n\tm\tsweep_us\traycast_us\tspeedup\tfactor\n";
+    for (size_t n : sizes) {
+        for (size_t m : batches) {
+            std::vector<Bench::Point> polygon = Bench::convex(n, 1e4, rng);
+            std::vector<Bench::Point> queries = Bench::uniform(m, polygon, rng);
+
+            Geometry::Answers swept;
+            Geometry::Answers cast;
+            double sweep = per_call([&]() {
+                MultiBelongingAlgorithm<Bench::Point> algorithm(polygon, queries);
+                algorithm.setOrder();
+                algorithm.setEdges();
+                algorithm.setEvents();
+                algorithm.sortEvents();
+                algorithm.run();
+                swept = algorithm.take_ans();
+            });
+            double raycast = per_call([&]() {
+                Geometry::RayCasting<Bench::Point> kernel(polygon);
+                cast = kernel.run(queries);
+            });
+
+            if (swept != cast) {
+                std::cerr << "raycast: answers differ for n=" << n << " m=" << m << '\n';
+                return 1;
+            }
+
+            // Lattice points on the edges, where the two border tests could part.
+            std::vector<Bench::Point> border = Bench::border(m, polygon, rng);
+            MultiBelongingAlgorithm<Bench::Point> algorithm(polygon, border);
+            algorithm.setOrder();
+            algorithm.setEdges();
+            algorithm.setEvents();
+            algorithm.sortEvents();
+            algorithm.run();
+            if (algorithm.ans() != Geometry::RayCasting<Bench::Point>(polygon).run(border)) {
+                std::cerr << "raycast: border answers differ for n=" << n << " m=" << m << '\n';
+                return 1;
+            }
+
+            // The factor at which RayCasting::preferable would flip for this (n, m).
+            size_t total = polygon.size() + m;
+            double factor = (double)polygon.size() * m / (total * std::ceil(std::log2(total)));
+            std::cout << polygon.size() << '\t' << m << '\t' << sweep * 1e6 << '\t' << raycast * 1e6 << '\t'
+                      << sweep / raycast << '\t' << factor << '\n';
+        }
+    }
+    return 0;
+}
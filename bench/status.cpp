@@ -0,0 +1,52 @@
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "bench.h"
+#include "belonging.h"
+#include "generators.h"
+#include "sweep_status.h"
+
+namespace {
+    template <class Status>
+    Geometry::Answers measure(const char *name, const std::vector<Bench::Point> &polygon,
+                                         const std::vector<Bench::Point> &queries) {
+        MultiBelongingAlgorithm<Bench::Point, Status> algorithm(polygon, queries);
+        algorithm.setOrder();
+        algorithm.setEdges();
+        algorithm.setEvents();
+        algorithm.sortEvents();
+
+        Bench::Timer timer;
+        algorithm.run();
+        double seconds = timer.seconds();
+        std::cout << "  " << name << ": " << seconds << " s, " << queries.size() / seconds / 1e6 << " Mq/s\n";
+        return algorithm.take_ans();
+    }
+
+    template <class Generator>
+    bool compare(const char *shape, Generator generate, size_t n, size_t m, std::mt19937_64 &rng) {
+        std::vector<Bench::Point> polygon = generate(n, rng);
+        std::vector<Bench::Point> queries = Bench::uniform(m, polygon, rng);
+
+        std::cout << shape << " n=" << polygon.size() << " m=" << m << '\n';
+        auto multiset = measure<Geometry::MultisetStatus<Bench::Point>>("multiset", polygon, queries);
+        auto blocks = measure<Geometry::BlockStatus<Bench::Point>>("blocks  ", polygon, queries);
+        if (multiset != blocks) {
+            std::cerr << "status: answers differ\n";
+            return false;
+        }
+        return true;
+    }
+}
+
+int Bench::status(int argc, char **argv) {
+    size_t n = (argc >= 1 ? std::atol(argv[0]) : 100000);
+    size_t m = (argc >= 2 ? std::atol(argv[1]) : 1000000);
+    std::mt19937_64 rng(42);
+
+    bool ok = compare("comb", [](size_t n, std::mt19937_64 &rng) { return Bench::comb(n, 1e6, rng); }, n, m, rng);
+    ok &= compare("convex", [](size_t n, std::mt19937_64 &rng) { return Bench::convex(n, 1e6, rng); }, n, m, rng);
+    return ok ? 0 : 1;
+}
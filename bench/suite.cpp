@@ -0,0 +1,105 @@
+#include <sys/resource.h>
+
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bench.h"
+#include "belonging.h"
+#include "generators.h"
+
+namespace {
+    using Polygon = std::function<std::vector<Bench::Point>(size_t, std::mt19937_64&)>;
+    using Queries = std::function<std::vector<Bench::Point>(size_t, const std::vector<Bench::Point>&, std::mt19937_64&)>;
+
+    struct Shape {
+        const char *name;
+        Polygon generate;
+    };
+
+    struct Distribution {
+        const char *name;
+        Queries generate;
+    };
+
+    double peak_rss_mb() {
+        struct rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        return usage.ru_maxrss / 1024.0;
+    }
+
+    void scenario(const Shape &shape, const Distribution &distribution, size_t n, size_t m, std::mt19937_64 &rng) {
+        std::vector<Bench::Point> polygon = shape.generate(n, rng);
+        std::vector<Bench::Point> queries = distribution.generate(m, polygon, rng);
+
+        double phases[7];
+        Bench::Timer total, timer;
+        MultiBelongingAlgorithm<Bench::Point> algorithm(polygon, queries);
+        phases[0] = timer.seconds();
+
+        timer.reset();
+        algorithm.setOrder();
+        phases[1] = timer.seconds();
+
+        timer.reset();
+        algorithm.setEdges();
+        phases[2] = timer.seconds();
+
+        timer.reset();
+        algorithm.setEvents();
+        phases[3] = timer.seconds();
+
+        timer.reset();
+        algorithm.sortEvents();
+        phases[4] = timer.seconds();
+
+        timer.reset();
+        algorithm.run();
+        phases[5] = timer.seconds();
+        phases[6] = total.seconds();
+
+        std::cout << std::left << std::setw(9) << shape.name << std::setw(10) << distribution.name << std::right
+                  << std::setw(9) << polygon.size() << std::setw(10) << m << std::fixed << std::setprecision(4);
+        for (double phase : phases)
+            std::cout << std::setw(10) << phase;
+        std::cout << std::setprecision(3) << std::setw(10) << m / phases[6] / 1e6
+                  << std::setprecision(1) << std::setw(10) << peak_rss_mb() << '\n';
+        std::cout.unsetf(std::ios::floatfield);
+    }
+}
+
+int Bench::suite(int argc, char **argv) {
+    size_t n = (argc >= 1 ? std::atol(argv[0]) : 100000);
+    size_t m = (argc >= 2 ? std::atol(argv[1]) : 1000000);
+    std::string only = (argc >= 3 ? argv[2] : "");
+    std::mt19937_64 rng(2024);
+
+    const Shape shapes[] = {
+            {"convex", [](size_t n, std::mt19937_64 &rng) { return Bench::convex(n, 1e7, rng); }},
+            {"star", [](size_t n, std::mt19937_64 &rng) { return Bench::star(n, 1e7, rng); }},
+            {"comb", [](size_t n, std::mt19937_64 &rng) { return Bench::comb(n, 1e6, rng); }},
+            {"skyline", [](size_t n, std::mt19937_64 &rng) { return Bench::skyline(n, 1e4, rng); }},
+    };
+    const Distribution distributions[] = {
+            {"uniform", Bench::uniform},
+            {"clustered", Bench::clustered},
+            {"border", Bench::border},
+    };
+
+    std::cout << std::left << std::setw(9) << "shape" << std::setw(10) << "queries" << std::right
+              << std::setw(9) << "n" << std::setw(10) << "m" << std::setw(10) << "ctor" << std::setw(10) << "order"
+              << std::setw(10) << "edges" << std::setw(10) << "events" << std::setw(10) << "sort"
+              << std::setw(10) << "run" << std::setw(10) << "total" << std::setw(10) << "Mq/s"
+              << std::setw(10) << "rss_mb" << '\n';
+    for (const Shape &shape : shapes) {
+        if (!only.empty() && only != shape.name)
+            continue;
+        for (const Distribution &distribution : distributions)
+            scenario(shape, distribution, n, m, rng);
+    }
+    return 0;
+}
@@ -0,0 +1,63 @@
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "answers.h"
+#include "bench.h"
+#include "generators.h"
+#include "polygon_index.h"
+#include "trapezoid_map.h"
+
+namespace {
+    int scenario(const char *name, const std::vector<Bench::Point> &polygon, size_t m, std::mt19937_64 &rng) {
+        std::vector<Bench::Point> queries = Bench::uniform(m, polygon, rng);
+        std::cout << name << " n=" << polygon.size() << " m=" << m << '\n';
+
+        Bench::Timer timer;
+        Geometry::PolygonIndex<Bench::Point> index(polygon);
+        double index_build = timer.seconds();
+
+        timer.reset();
+        Geometry::Answers expected(queries.size());
+        for (size_t i = 0; i < queries.size(); ++i)
+            expected.set(i, index.locate(queries[i]));
+        double index_query = timer.seconds();
+
+        timer.reset();
+        Geometry::TrapezoidMap<Bench::Point> map(polygon, rng());
+        double map_build = timer.seconds();
+
+        timer.reset();
+        Geometry::Answers ans(queries.size());
+        for (size_t i = 0; i < queries.size(); ++i)
+            ans.set(i, map.locate(queries[i]));
+        double map_query = timer.seconds();
+
+        std::cout << "  index    : build " << index_build << " s, query " << index_query << " s, "
+                  << index.nodes() << " nodes\n"
+                  << "  trapezoid: build " << map_build << " s, query " << map_query << " s, "
+                  << map.nodes() << " nodes, query speedup " << index_query / map_query << '\n';
+
+        if (ans != expected) {
+            std::cerr << "trapezoids: answers differ on " << name << '\n';
+            return 1;
+        }
+        return 0;
+    }
+}
+
+// The persistent-treap PolygonIndex against the trapezoidal map, both built
+// once and queried one point at a time, on a shape without vertical edges and
+// two made of them.
+int Bench::trapezoids(int argc, char **argv) {
+    size_t n = (argc >= 1 ? std::atol(argv[0]) : 100000);
+    size_t m = (argc >= 2 ? std::atol(argv[1]) : 1000000);
+    std::mt19937_64 rng(25);
+
+    int status = 0;
+    status |= scenario("star", Bench::star(n, 1e7, rng), m, rng);
+    status |= scenario("comb", Bench::comb(n, 1e6, rng), m, rng);
+    status |= scenario("skyline", Bench::skyline(n, 1e4, rng), m, rng);
+    return status;
+}
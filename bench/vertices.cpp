@@ -0,0 +1,91 @@
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "bench.h"
+#include "generators.h"
+#include "geometry.h"
+#include "vertex_set.h"
+
+namespace {
+    // Builds a vertex container with insert and probes it with every query; returns the hit count.
+    template <class Set, class Insert, class Contains>
+    size_t measure(const char *name, const std::vector<Bench::Point> &polygon,
+                   const std::vector<Bench::Point> &queries, Set set, Insert insert, Contains contains) {
+        Bench::Timer timer;
+        insert(set, polygon);
+        double build = timer.seconds();
+
+        timer.reset();
+        size_t hits = 0;
+        for (const Bench::Point &q : queries)
+            hits += contains(set, q);
+        double probe = timer.seconds();
+
+        std::cout << "  " << name << ": build " << build << " s, probe " << probe << " s, "
+                  << queries.size() / probe / 1e6 << " Mq/s\n";
+        return hits;
+    }
+
+    // The sorted vertex array PolygonIndex and TrapezoidMap search, ordered by Less.
+    template <class Less>
+    struct SortedVertices {
+        std::vector<Bench::Point> points;
+        Less less;
+    };
+
+    template <class Less>
+    void sort_vertices(SortedVertices<Less> &set, const std::vector<Bench::Point> &polygon) {
+        set.points = polygon;
+        std::sort(set.points.begin(), set.points.end(), set.less);
+    }
+
+    template <class Less>
+    bool search_vertices(const SortedVertices<Less> &set, const Bench::Point &q) {
+        return std::binary_search(set.points.begin(), set.points.end(), q, set.less);
+    }
+}
+
+// Vertex-heavy workload: half of the queries are polygon vertices, the rest
+// lie on the edges. Compares the sorted vertex array of the point-location
+// indexes searched through a type-erased comparator and through
+// LexicographicLess, and the VertexSet the sweep and AdvancedPolygon use.
+int Bench::vertices(int argc, char **argv) {
+    size_t n = (argc >= 1 ? std::atol(argv[0]) : 100000);
+    size_t m = (argc >= 2 ? std::atol(argv[1]) : 1000000);
+    std::mt19937_64 rng(11);
+
+    std::vector<Bench::Point> polygon = Bench::star(n, 1e6, rng);
+    std::vector<Bench::Point> queries = Bench::border(m / 2, polygon, rng);
+    std::uniform_int_distribution<size_t> vertex(0, polygon.size() - 1);
+    while (queries.size() < m)
+        queries.push_back(polygon[vertex(rng)]);
+    std::shuffle(queries.begin(), queries.end(), rng);
+
+    using Function = std::function<bool(const Bench::Point&, const Bench::Point&)>;
+    using Functor = Geometry::LexicographicLess<Bench::Point>;
+
+    std::cout << "star n=" << polygon.size() << " m=" << m << '\n';
+    size_t erased = measure("std::function", polygon, queries, SortedVertices<Function>{{}, Functor()},
+                            sort_vertices<Function>, search_vertices<Function>);
+    size_t functor = measure("functor      ", polygon, queries, SortedVertices<Functor>(),
+                             sort_vertices<Functor>, search_vertices<Functor>);
+    size_t hashed = measure("hash set     ", polygon, queries, Geometry::VertexSet<Bench::Point>(),
+                            [](Geometry::VertexSet<Bench::Point> &set, const std::vector<Bench::Point> &points) {
+                                set.reserve(points.size());
+                                for (const Bench::Point &p : points)
+                                    set.insert(p);
+                            },
+                            [](const Geometry::VertexSet<Bench::Point> &set, const Bench::Point &q) {
+                                return set.contains(q);
+                            });
+
+    if (erased != functor || erased != hashed) {
+        std::cerr << "vertices: hit counts differ\n";
+        return 1;
+    }
+    return 0;
+}
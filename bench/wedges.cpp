@@ -0,0 +1,72 @@
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "bench.h"
+#include "belonging.h"
+#include "convex.h"
+#include "generators.h"
+
+// Rounding the circle to the grid leaves a few reflex vertices; the monotone
+// chain hull drops them so the polygon really is convex.
+static std::vector<Bench::Point> hull(std::vector<Bench::Point> points) {
+    std::sort(points.begin(), points.end(), Geometry::LexicographicLess<Bench::Point>());
+    std::vector<Bench::Point> chain;
+    for (int pass = 0; pass < 2; ++pass) {
+        size_t start = chain.size();
+        for (const Bench::Point &p : points) {
+            while (chain.size() >= start + 2 && Geometry::turn(chain[chain.size() - 2], chain.back(), p) <= 0)
+                chain.pop_back();
+            chain.push_back(p);
+        }
+        chain.pop_back();
+        std::reverse(points.begin(), points.end());
+    }
+    Bench::number(chain);
+    return chain;
+}
+
+// A convex polygon and uniform queries over its bounding box: the general
+// sweep against wedge binary search on one thread and on every core.
+int Bench::wedges(int argc, char **argv) {
+    size_t n = (argc >= 1 ? std::atol(argv[0]) : 100000);
+    size_t m = (argc >= 2 ? std::atol(argv[1]) : 2000000);
+    size_t threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    std::mt19937_64 rng(24);
+
+    std::vector<Bench::Point> polygon = hull(Bench::convex(n, 1e6, rng));
+    std::vector<Bench::Point> queries = Bench::uniform(m, polygon, rng);
+    std::cout << "wedges n=" << polygon.size() << " m=" << m << " convex=" << Geometry::convex(polygon) << '\n';
+
+    Bench::Timer timer;
+    MultiBelongingAlgorithm<Bench::Point> algorithm(polygon, queries);
+    algorithm.setOrder();
+    algorithm.setEdges();
+    algorithm.setEvents();
+    algorithm.sortEvents();
+    algorithm.run();
+    double sweep = timer.seconds();
+
+    timer.reset();
+    Geometry::ConvexWedges<Bench::Point> wedges(polygon);
+    Geometry::Answers one = wedges.run(queries);
+    double single = timer.seconds();
+
+    timer.reset();
+    Geometry::Answers all = wedges.run(queries, threads);
+    double parallel = timer.seconds();
+
+    std::cout << "  sweep          : " << sweep << " s\n"
+              << "  wedges         : " << single << " s, speedup " << sweep / single << '\n'
+              << "  wedges x" << threads << (threads < 10 ? " " : "") << "     : " << parallel << " s, speedup "
+              << sweep / parallel << '\n';
+
+    if (one != algorithm.ans() || all != algorithm.ans()) {
+        std::cerr << "wedges: answers differ\n";
+        return 1;
+    }
+    return 0;
+}
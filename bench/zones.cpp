@@ -0,0 +1,64 @@
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "bench.h"
+#include "belonging.h"
+#include "generators.h"
+#include "multi_polygon.h"
+
+// Many zone polygons scattered over one square, one uniform query cloud over
+// the same square. Compares one MultiPolygonAlgorithm pass with a separate
+// MultiBelongingAlgorithm run per polygon and checks that they agree.
+int Bench::zones(int argc, char **argv) {
+    size_t polygons = (argc >= 1 ? std::atol(argv[0]) : 50);
+    size_t n = (argc >= 2 ? std::atol(argv[1]) : 1000);
+    size_t m = (argc >= 3 ? std::atol(argv[2]) : 200000);
+    const double side = 1e6, radius = 5e4;
+    std::mt19937_64 rng(19);
+
+    std::uniform_real_distribution<double> centre(radius, side - radius);
+    std::vector<std::vector<Bench::Point>> zones;
+    for (size_t k = 0; k < polygons; ++k) {
+        std::vector<Bench::Point> polygon = (k % 2 ? Bench::convex(n, radius, rng) : Bench::star(n, radius, rng));
+        double cx = std::round(centre(rng)), cy = std::round(centre(rng));
+        for (Bench::Point &p : polygon)
+            p = Bench::Point(p.getX() + cx, p.getY() + cy, p.getId());
+        zones.push_back(polygon);
+    }
+
+    std::vector<Bench::Point> square = {Bench::Point(0, 0, 0), Bench::Point(side, 0, 1), Bench::Point(side, side, 2),
+                                        Bench::Point(0, side, 3)};
+    std::vector<Bench::Point> queries = Bench::uniform(m, square, rng);
+    std::cout << "zones polygons=" << polygons << " n=" << n << " m=" << m << '\n';
+
+    Bench::Timer timer;
+    std::vector<Geometry::Answers> separate;
+    for (const std::vector<Bench::Point> &polygon : zones) {
+        MultiBelongingAlgorithm<Bench::Point> algorithm(polygon, queries);
+        algorithm.setOrder();
+        algorithm.setEdges();
+        algorithm.setEvents();
+        algorithm.sortEvents();
+        algorithm.run();
+        separate.push_back(algorithm.take_ans());
+    }
+    double each = timer.seconds();
+
+    timer.reset();
+    MultiPolygonAlgorithm<Bench::Point> algorithm(zones, queries);
+    algorithm.run();
+    double shared = timer.seconds();
+
+    std::cout << "  per polygon: " << each << " s\n"
+              << "  one pass   : " << shared << " s, " << algorithm.hits().size() << " hits, speedup "
+              << each / shared << '\n';
+
+    if (algorithm.matrix() != separate) {
+        std::cerr << "zones: answers differ\n";
+        return 1;
+    }
+    return 0;
+}
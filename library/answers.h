@@ -0,0 +1,99 @@
+#ifndef GEOM_ANSWERS_H
+#define GEOM_ANSWERS_H
+
+#include <cstdint>
+#include <vector>
+
+#include "geometry.h"
+
+namespace Geometry {
+    // Query answers packed as 2-bit State codes, 32 to a 64-bit word (answer i
+    // in bits 2 (i % 32) of word i / 32), a sixteenth of a std::vector<State>.
+    // Bits past size() are always zero, so the words can be written out as is.
+    class Answers {
+    private:
+        using size_type = size_t;
+
+        std::vector<uint64_t> _words;
+        size_type _size = 0;
+
+        static size_type _shift(size_type i) {
+            return 2 * (i % 32);
+        }
+    public:
+        Answers() = default;
+
+        explicit Answers(size_type size) {
+            resize(size);
+        }
+
+        explicit Answers(const std::vector<State> &states) {
+            resize(states.size());
+            for (size_type i = 0; i < states.size(); ++i)
+                set(i, states[i]);
+        }
+
+        // New answers start as OUTSIDE.
+        void resize(size_type size) {
+            if (size < _size) {
+                for (size_type i = size; i < _size && i % 32 != 0; ++i)
+                    set(i, State::OUTSIDE);
+            }
+            _words.resize((size + 31) / 32, 0);
+            _size = size;
+        }
+
+        void clear() {
+            _words.clear();
+            _size = 0;
+        }
+
+        size_type size() const {
+            return _size;
+        }
+
+        bool empty() const {
+            return _size == 0;
+        }
+
+        State operator[](size_type i) const {
+            return static_cast<State>((_words[i / 32] >> _shift(i)) & 3);
+        }
+
+        void set(size_type i, State state) {
+            uint64_t &word = _words[i / 32];
+            word = (word & ~(uint64_t(3) << _shift(i))) | (uint64_t(state) << _shift(i));
+        }
+
+        // Sets answer i to max(answer i, state). Safe against concurrent updates of
+        // other answers sharing the word, which is what the slab sweep needs.
+        void raise(size_type i, State state) {
+            uint64_t *word = &_words[i / 32];
+            uint64_t current = __atomic_load_n(word, __ATOMIC_RELAXED), next;
+            do {
+                if (static_cast<State>((current >> _shift(i)) & 3) >= state)
+                    return;
+                next = (current & ~(uint64_t(3) << _shift(i))) | (uint64_t(state) << _shift(i));
+            } while (!__atomic_compare_exchange_n(word, &current, next, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+        }
+
+        const uint64_t* words() const {
+            return _words.data();
+        }
+
+        size_type word_count() const {
+            return _words.size();
+        }
+
+        bool operator==(const Answers &other) const {
+            return _size == other._size && _words == other._words;
+        }
+
+        bool operator!=(const Answers &other) const {
+            return !(*this == other);
+        }
+    };
+}
+
+
+#endif //GEOM_ANSWERS_H
@@ -0,0 +1,136 @@
+#ifndef GEOM_ARENA_H
+#define GEOM_ARENA_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <scoped_allocator>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace Memory {
+    // Monotonic bump allocator. Memory is only given back all at once by
+    // release(), which keeps the blocks for the next round, so an arena that
+    // is released between tests stops calling malloc once it has warmed up.
+    class Arena {
+    private:
+        using size_type = size_t;
+
+        struct Block {
+            std::unique_ptr<char[]> data;
+            size_type size;
+        };
+
+        static const size_type min_block = 64 * 1024;
+
+        std::vector<Block> _blocks;
+        size_type _current = 0;
+        size_type _offset = 0;
+
+        static size_type _align(size_type offset, size_type alignment) {
+            return (offset + alignment - 1) & ~(alignment - 1);
+        }
+    public:
+        Arena() = default;
+
+        Arena(const Arena&) = delete;
+        Arena& operator=(const Arena&) = delete;
+
+        void* allocate(size_type bytes, size_type alignment = alignof(std::max_align_t)) {
+            while (_current < _blocks.size()) {
+                size_type start = _align(_offset, alignment);
+                if (start + bytes <= _blocks[_current].size) {
+                    _offset = start + bytes;
+                    return _blocks[_current].data.get() + start;
+                }
+                _current++;
+                _offset = 0;
+            }
+
+            // A copy, so std::max does not bind (and ODR-use) the undefined member.
+            size_type size = std::max(size_type(min_block), bytes + alignment);
+            if (!_blocks.empty())
+                size = std::max(size, 2 * _blocks.back().size);
+            _blocks.push_back(Block{std::unique_ptr<char[]>(new char[size]), size});
+            _current = _blocks.size() - 1;
+
+            size_type start = _align(reinterpret_cast<uintptr_t>(_blocks[_current].data.get()), alignment)
+                              - reinterpret_cast<uintptr_t>(_blocks[_current].data.get());
+            _offset = start + bytes;
+            return _blocks[_current].data.get() + start;
+        }
+
+        // Invalidates everything allocated so far but keeps the blocks.
+        void release() {
+            _current = 0;
+            _offset = 0;
+        }
+
+        size_type capacity() const {
+            size_type total = 0;
+            for (const Block &block : _blocks)
+                total += block.size;
+            return total;
+        }
+    };
+
+    // Standard allocator on top of an Arena; deallocation is a no-op. Without an
+    // arena it falls back to the global heap, so containers declared with it can
+    // still be used on their own.
+    template <class T>
+    class ArenaAllocator {
+    private:
+        template <class U>
+        friend class ArenaAllocator;
+
+        Arena *_arena;
+    public:
+        using value_type = T;
+        // Lets a container be moved onto a different arena, or off it (see AdvancedPolygon).
+        using propagate_on_container_move_assignment = std::true_type;
+
+        ArenaAllocator(Arena *arena = nullptr) : _arena(arena) {}
+
+        template <class U>
+        ArenaAllocator(const ArenaAllocator<U> &other) : _arena(other._arena) {}
+
+        T* allocate(size_t n) {
+            if (_arena == nullptr)
+                return static_cast<T*>(::operator new(n * sizeof(T)));
+            return static_cast<T*>(_arena->allocate(n * sizeof(T), alignof(T)));
+        }
+
+        void deallocate(T *p, size_t) {
+            if (_arena == nullptr)
+                ::operator delete(p);
+        }
+
+        Arena* arena() const {
+            return _arena;
+        }
+
+        template <class U>
+        bool operator==(const ArenaAllocator<U> &other) const {
+            return _arena == other._arena;
+        }
+
+        template <class U>
+        bool operator!=(const ArenaAllocator<U> &other) const {
+            return _arena != other._arena;
+        }
+    };
+
+    template <class T>
+    using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+    // The scoped adaptor hands the arena down to the mapped containers as well.
+    template <class K, class V>
+    using ArenaMap = std::map<K, V, std::less<K>, std::scoped_allocator_adaptor<ArenaAllocator<std::pair<const K, V>>>>;
+}
+
+
+#endif //GEOM_ARENA_H
@@ -0,0 +1,697 @@
+#ifndef GEOM_BELONGING_H
+#define GEOM_BELONGING_H
+
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "answers.h"
+#include "arena.h"
+#include "cell_grid.h"
+#include "geometry.h"
+#include "polygon_index.h"
+#include "radix_sort.h"
+#include "stats.h"
+#include "sweep_status.h"
+
+template <class T, class Status = Geometry::BlockStatus<T>>
+class MultiBelongingAlgorithm {
+private:
+    template <class U>
+    class Event {
+    public:
+        enum Type {
+            QUERY,
+            CLOSE,
+            OPEN,
+        };
+    private:
+        ssize_t _id;
+        Type type;
+        U p;
+    public:
+        Event(ssize_t id, Type type, U p) : _id(id), type(type), p(p) {}
+
+        const U& getPoint() const {
+            return p;
+        }
+
+        ssize_t getId() const {
+            return _id;
+        }
+
+        Type getType() const {
+            return type;
+        }
+
+        bool operator<(const Event& other) const {
+            if (p.getX() == other.p.getX()) {
+                return type < other.type;
+            }
+
+            return p.getX() < other.p.getX();
+        }
+    };
+
+    using value = T;
+    using reference = T&;
+    using const_reference = const T&;
+    using pointer = T*;
+    using size_type = size_t;
+
+    Geometry::Points<value> _query;
+    Geometry::Answers _ans;
+
+    // Declared first: the node-based members below allocate from it, and it is
+    // rewound by reset() once they have been cleared. It covers the vertical
+    // edge map and a MultisetStatus; the default BlockStatus pools its own blocks.
+    // Polygon edits stay off it (see _edit_open), as it would grow with each.
+    Memory::Arena _arena;
+
+    std::vector<Event<T>> _events;
+    Geometry::AdvancedPolygon<T> _polygon;
+    using coordinate = decltype(std::declval<const T&>().getX());
+
+    // Scratch space kept between runs of a reused engine.
+    std::vector<Event<T>> _vertical_events;
+    std::vector<Geometry::RadixItem> _items;
+    std::vector<Event<T>> _sorted;
+    std::vector<Event<T>> _dirty_events;
+    Status _open;
+    // The status of _resweep, on the heap.
+    Status _edit_open;
+
+    // Whether the region just above each edge is inside the polygon. For one
+    // ring that is the edge's Position being UP; with several rings it also
+    // depends on how the ring is nested (see _nest).
+    std::vector<uint8_t> _inside_above;
+    Geometry::FillRule _rule = Geometry::FillRule::EVEN_ODD;
+    size_type _grid_cells = 0;
+    // Queries answered by the prefilter in setEvents(), which have no event.
+    std::vector<uint8_t> _settled;
+
+    // Incremental mode: queries inserted since the last run() or update() wait
+    // in _pending (the first _located of them already answered), erased ones
+    // are flagged in _erased, and both are folded into _events lazily by
+    // _compact(). _stale counts erased queries not yet removed.
+    std::vector<Event<T>> _pending;
+    std::vector<uint8_t> _erased;
+    size_type _located = 0;
+    size_type _stale = 0;
+
+    // Set by polygon edits: the edge events in _events no longer match the
+    // edges and are rebuilt by the next run().
+    bool _edges_changed = false;
+    std::unique_ptr<Geometry::PolygonIndex<T>> _index;
+
+    static const size_type min_slab_events = 1 << 14;
+    // update() compacts once the changes reach this fraction of the events.
+    static const size_type compact_divisor = 4;
+
+    static int _redirection(typename Event<T>::Type e) {
+        switch (e) {
+            case Event<T>::Type::OPEN:
+                return -1;
+            case Event<T>::Type::CLOSE:
+                return 1;
+            case Event<T>::Type::QUERY:
+                return 0;
+        }
+        return 0;
+    }
+
+    // Events on one vertical line: by y, opens before queries before closes.
+    struct VerticalLess {
+        bool operator()(const Event<T> &a, const Event<T> &b) const {
+            if (a.getPoint().getY() == b.getPoint().getY()) {
+                return _redirection(a.getType()) < _redirection(b.getType());
+            }
+
+            return a.getPoint().getY() < b.getPoint().getY();
+        }
+    };
+
+    // Orders sorted events against a bare x.
+    struct XLess {
+        bool operator()(const Event<T> &e, coordinate x) const {
+            return e.getPoint().getX() < x;
+        }
+
+        bool operator()(coordinate x, const Event<T> &e) const {
+            return x < e.getPoint().getX();
+        }
+    };
+
+    template <class Verticals, class It>
+    void _prepare(const Verticals &verticals, It first, It last, std::vector<Event<T>> &ev) {
+        ev.clear();
+        int j = 0;
+        for (const Geometry::Edge<T> &i : verticals) {
+            ev.push_back(Event<T>(j, Event<T>::Type::OPEN, i.minY()));
+            ev.push_back(Event<T>(j, Event<T>::Type::CLOSE, i.maxY()));
+            j++;
+        }
+
+        for (; first != last; ++first) {
+            if (first->getType() == Event<T>::Type::QUERY)
+                ev.push_back(*first);
+        }
+    }
+
+    void _peform(const std::vector<Event<T>> &ev) {
+        int balance = 0;
+        for (const Event<T>& i : ev) {
+            if (i.getType() == Event<T>::Type::OPEN)
+                balance++;
+            if (i.getType() == Event<T>::Type::CLOSE)
+                balance--;
+            if (i.getType() == Event<T>::Type::QUERY && balance > 0)
+                _ans.set(i.getId(), Geometry::State::BORDER);
+        }
+    }
+
+    // Finds the queries on every vertical line in [first, last) of the
+    // vertical edge map by binary search in the sorted events.
+    template <class It>
+    void _verticals(const std::vector<Event<T>> &events, It first, It last) {
+        for (; first != last; ++first) {
+            auto on = std::equal_range(events.begin(), events.end(), first->first, XLess());
+            if (on.first == on.second)
+                continue;
+            _prepare(first->second, on.first, on.second, _vertical_events);
+            sort(_vertical_events.begin(), _vertical_events.end(), VerticalLess());
+            _peform(_vertical_events);
+        }
+    }
+
+    void _answer_for_verticals() {
+        GEOM_STATS_TIMER(VERTICALS);
+        _verticals(_events, _polygon.getVerticalEdges().begin(), _polygon.getVerticalEdges().end());
+    }
+
+    // Sweeps events[begin, end) starting from the open edges listed in seed.
+    void _sweep(Status &open, const std::vector<Event<T>> &events, size_type begin, size_type end,
+                const std::vector<size_type> &seed) {
+        const std::vector<Geometry::Edge<T>> &edges = _polygon.getEdges();
+        for (size_type id : seed)
+            open.insert(id);
+
+        for (size_type i = begin; i < end; ++i) {
+            const Event<T> &e = events[i];
+            switch (e.getType()) {
+                case Event<T>::OPEN:
+                    open.insert(e.getId());
+                    GEOM_STATS_COUNT(INSERT, 1);
+                    break;
+                case Event<T>::CLOSE:
+                    open.erase(e.getId());
+                    GEOM_STATS_COUNT(ERASE, 1);
+                    break;
+                case Event<T>::QUERY:
+                    if (open.empty())
+                        continue;
+                    GEOM_STATS_COUNT(PROBE, 1);
+
+                    std::pair<ssize_t, ssize_t> around = open.locate(e.getPoint());
+                    // raise() because slabs running in parallel may share answer words.
+                    if (around.second >= 0 && edges[around.second].side(e.getPoint()) == 0)
+                        _ans.raise(e.getId(), Geometry::State::BORDER);
+                    if (around.first >= 0 && _inside_above[around.first])
+                        _ans.raise(e.getId(), Geometry::State::INSIDE);
+                    break;
+            }
+        }
+    }
+
+    // Finds, for every ring, how many rings contain it and their total winding,
+    // by sweeping the edges with the leftmost vertex of each ring as a query.
+    // The edge directly below that vertex belongs to a ring whose leftmost
+    // vertex comes earlier, so rings resolve in sweep order. The region just
+    // above an edge of ring r then lies in the rings containing r, plus r
+    // itself when the edge is UP (every ring is clockwise after setOrder).
+    void _nest() {
+        const std::vector<Geometry::Edge<T>> &edges = _polygon.getEdges();
+        const Geometry::Points<value> &points = _polygon.getPoints();
+        size_type rings = _polygon.rings();
+
+        std::vector<Event<T>> events;
+        for (size_type r = 0; r < rings; ++r) {
+            size_type leftmost = _polygon.ringBegin(r);
+            for (size_type i = leftmost; i < _polygon.ringEnd(r); ++i) {
+                if (Geometry::LexicographicLess<T>()(points[i], points[leftmost]))
+                    leftmost = i;
+            }
+            events.push_back(Event<T>(r, Event<T>::QUERY, points[leftmost]));
+        }
+        std::sort(events.begin(), events.end(), [](const Event<T> &a, const Event<T> &b) {
+            return Geometry::LexicographicLess<T>()(a.getPoint(), b.getPoint());
+        });
+        for (const Geometry::Edge<T> &e : edges) {
+            if (e.getPosition() != Geometry::Position::VERTICAL) {
+                events.push_back(Event<T>(e.getId(), Event<T>::OPEN, e.minX()));
+                events.push_back(Event<T>(e.getId(), Event<T>::CLOSE, e.maxX()));
+            }
+        }
+        std::stable_sort(events.begin(), events.end());
+
+        std::vector<int> depth(rings, 0), winding(rings, 0);
+        auto above = [&](size_type edge, int &d, int &w) {
+            size_type ring = _polygon.ringOf(edge);
+            bool up = (edges[edge].getPosition() == Geometry::Position::UP);
+            d = depth[ring] + up;
+            w = winding[ring] + (up ? _polygon.getWinding(ring) : 0);
+        };
+
+        Status open(edges);
+        for (const Event<T> &e : events) {
+            if (e.getType() == Event<T>::OPEN) {
+                open.insert(e.getId());
+            } else if (e.getType() == Event<T>::CLOSE) {
+                open.erase(e.getId());
+            } else if (!open.empty()) {
+                ssize_t below = open.locate(e.getPoint()).first;
+                if (below >= 0)
+                    above(below, depth[e.getId()], winding[e.getId()]);
+            }
+        }
+
+        for (size_type i = 0; i < edges.size(); ++i) {
+            int d, w;
+            above(i, d, w);
+            _inside_above[i] = (_rule == Geometry::FillRule::EVEN_ODD ? d % 2 != 0 : w != 0);
+        }
+    }
+
+    bool _live(const Event<T> &e) const {
+        return e.getType() != Event<T>::QUERY || !_erased[e.getId()];
+    }
+
+    // Drops erased queries and merges the pending ones into the sorted events,
+    // in one linear pass plus sorting the pending queries.
+    void _compact() {
+        _erased.resize(_query.size());
+        if (_stale != 0) {
+            auto dead = [this](const Event<T> &e) { return !_live(e); };
+            _events.erase(std::remove_if(_events.begin(), _events.end(), dead), _events.end());
+            _pending.erase(std::remove_if(_pending.begin(), _pending.end(), dead), _pending.end());
+            _stale = 0;
+        }
+
+        if (!_pending.empty()) {
+            std::sort(_pending.begin(), _pending.end());
+            _sorted.clear();
+            _sorted.reserve(_events.size() + _pending.size());
+            std::merge(_events.begin(), _events.end(), _pending.begin(), _pending.end(), std::back_inserter(_sorted));
+            _events.swap(_sorted);
+            _pending.clear();
+        }
+        _located = 0;
+    }
+
+    // Replaces the edge events of _events after polygon edits: one pass to
+    // drop the old ones and one merge with the new ones, queries untouched.
+    void _refresh_edge_events() {
+        _events.erase(std::remove_if(_events.begin(), _events.end(), [](const Event<T> &e) {
+            return e.getType() != Event<T>::QUERY;
+        }), _events.end());
+
+        _dirty_events.clear();
+        for (const Geometry::Edge<T> &e : _polygon.getEdges()) {
+            if (e.getPosition() != Geometry::Position::VERTICAL) {
+                _dirty_events.push_back(Event<T>(e.getId(), Event<T>::OPEN, e.minX()));
+                _dirty_events.push_back(Event<T>(e.getId(), Event<T>::CLOSE, e.maxX()));
+            }
+        }
+        std::stable_sort(_dirty_events.begin(), _dirty_events.end());
+
+        _sorted.clear();
+        _sorted.reserve(_events.size() + _dirty_events.size());
+        std::merge(_events.begin(), _events.end(), _dirty_events.begin(), _dirty_events.end(),
+                   std::back_inserter(_sorted));
+        _events.swap(_sorted);
+        _edges_changed = false;
+    }
+
+    void _classify() {
+        const std::vector<Geometry::Edge<T>> &edges = _polygon.getEdges();
+        _inside_above.resize(edges.size());
+        if (_polygon.rings() > 1) {
+            _nest();
+            return;
+        }
+        for (size_type i = 0; i < edges.size(); ++i)
+            _inside_above[i] = (edges[i].getPosition() == Geometry::Position::UP);
+    }
+
+    // Re-answers the live queries with x in span after a polygon edit: the
+    // vertical pass for the lines inside it, then a sweep over the queries in
+    // it and the edges crossing it, seeded like a slab with the edges already
+    // open at span.low. Queries settled by setEvents() without an event are
+    // found by a linear scan. Pending queries stay pending: those outside the
+    // span are still answered by the next update(), against the new edges.
+    void _resweep(Geometry::Span<coordinate> span) {
+        GEOM_STATS_TIMER(SWEEP);
+        _erased.resize(_query.size());
+        _index.reset();
+        _classify();
+        _edges_changed = true;
+
+        _dirty_events.clear();
+        auto first = std::lower_bound(_events.begin(), _events.end(), span.low, XLess());
+        auto last = std::upper_bound(first, _events.end(), span.high, XLess());
+        for (; first != last; ++first) {
+            if (first->getType() == Event<T>::QUERY && !_erased[first->getId()])
+                _dirty_events.push_back(*first);
+        }
+        for (const Event<T> &e : _pending) {
+            const T &p = e.getPoint();
+            if (!_erased[e.getId()] && span.low <= p.getX() && p.getX() <= span.high)
+                _dirty_events.push_back(e);
+        }
+        for (size_type id = 0; id < _settled.size(); ++id) {
+            const T &p = _query[id];
+            if (_settled[id] && !_erased[id] && span.low <= p.getX() && p.getX() <= span.high)
+                _dirty_events.push_back(Event<T>(id, Event<T>::QUERY, p));
+        }
+        std::sort(_dirty_events.begin(), _dirty_events.end());
+
+        for (const Event<T> &e : _dirty_events) {
+            _ans.set(e.getId(), _polygon.isVertex(e.getPoint()) ? Geometry::State::BORDER
+                                                                : Geometry::State::OUTSIDE);
+        }
+        const auto &verticals = _polygon.getVerticalEdges();
+        _verticals(_dirty_events, verticals.lower_bound(span.low), verticals.upper_bound(span.high));
+
+        const std::vector<Geometry::Edge<T>> &edges = _polygon.getEdges();
+        std::vector<size_type> seed;
+        for (const Geometry::Edge<T> &e : edges) {
+            if (e.getPosition() == Geometry::Position::VERTICAL || e.maxX().getX() < span.low ||
+                e.minX().getX() > span.high)
+                continue;
+            if (e.minX().getX() < span.low)
+                seed.push_back(e.getId());
+            else
+                _dirty_events.push_back(Event<T>(e.getId(), Event<T>::OPEN, e.minX()));
+            if (e.maxX().getX() <= span.high)
+                _dirty_events.push_back(Event<T>(e.getId(), Event<T>::CLOSE, e.maxX()));
+        }
+        std::sort(seed.begin(), seed.end(), [&edges](size_type a, size_type b) {
+            if (edges[a].minX().getX() == edges[b].minX().getX()) {
+                return a < b;
+            }
+            return edges[a].minX().getX() < edges[b].minX().getX();
+        });
+        std::stable_sort(_dirty_events.begin(), _dirty_events.end());
+
+        _edit_open.clear();
+        _sweep(_edit_open, _dirty_events, 0, _dirty_events.size(), seed);
+    }
+
+    void _answer_for_others() {
+        GEOM_STATS_TIMER(SWEEP);
+        _open.clear();
+        _sweep(_open, _events, 0, _events.size(), std::vector<size_type>());
+    }
+
+    // Splits _events into slabs of equal length. The status of a slab starting at
+    // event b is exactly the edges opened before b and closed at or after b; they
+    // are seeded in opening order, so every slab reproduces the sequential sweep.
+    void _answer_for_others(size_type slabs) {
+        GEOM_STATS_TIMER(SWEEP);
+        Stats::Record *record = Stats::current();
+        size_type edges = _polygon.getEdges().size();
+        std::vector<size_type> opened(edges, _events.size()), closed(edges, _events.size());
+        for (size_type i = 0; i < _events.size(); ++i) {
+            if (_events[i].getType() == Event<T>::OPEN)
+                opened[_events[i].getId()] = i;
+            else if (_events[i].getType() == Event<T>::CLOSE)
+                closed[_events[i].getId()] = i;
+        }
+
+        std::vector<std::thread> workers;
+        for (size_type k = 0; k < slabs; ++k) {
+            size_type begin = _events.size() * k / slabs;
+            size_type end = _events.size() * (k + 1) / slabs;
+
+            std::vector<size_type> seed;
+            for (size_type id = 0; id < edges; ++id) {
+                if (opened[id] < begin && closed[id] >= begin)
+                    seed.push_back(id);
+            }
+            std::sort(seed.begin(), seed.end(), [&opened](size_type a, size_type b) {
+                return opened[a] < opened[b];
+            });
+
+            workers.emplace_back([this, begin, end, record](const std::vector<size_type> &seed) {
+                GEOM_STATS_SCOPE(record);
+                // The engine arena is not thread-safe, so every slab gets its own.
+                Memory::Arena arena;
+                Status open(_polygon.getEdges(), &arena);
+                _sweep(open, _events, begin, end, seed);
+            }, std::move(seed));
+        }
+
+        for (std::thread &t : workers)
+            t.join();
+    }
+public:
+    MultiBelongingAlgorithm() :
+            _polygon(&_arena), _open(_polygon.getEdges(), &_arena), _edit_open(_polygon.getEdges()) {}
+
+    MultiBelongingAlgorithm(const Geometry::Points<value>& _points, const Geometry::Points<value>& _queries) :
+            MultiBelongingAlgorithm() {
+        reset(_points, _queries);
+    }
+
+    // The status and the arena refer back into the engine, so it is not copyable.
+    MultiBelongingAlgorithm(const MultiBelongingAlgorithm&) = delete;
+    MultiBelongingAlgorithm& operator=(const MultiBelongingAlgorithm&) = delete;
+
+    // Loads a new polygon and query set. Vectors keep their capacity and the
+    // maps go back to the arena, so a warmed-up engine reused across tests
+    // does almost no heap allocation before the sweep.
+    void reset(const Geometry::Points<value>& _points, const Geometry::Points<value>& _queries) {
+        clear();
+        _polygon.clear();
+        _arena.release();
+
+        _polygon.assign(_points);
+        reserve_query(_queries.size());
+        for (auto q : _queries)
+            push_query(q);
+    }
+
+    // Splits the polygon into rings (shells and holes) starting at the given
+    // point offsets; rings must not cross each other. Call after reset().
+    void setRings(const std::vector<size_type> &starts, Geometry::FillRule rule = Geometry::FillRule::EVEN_ODD) {
+        _polygon.setRings(starts);
+        _rule = rule;
+    }
+
+    void setOrder() {
+        GEOM_STATS_TIMER(ORDER);
+        if (_polygon.rings() > 1) {
+            _polygon.orientRings();
+        } else if (_polygon.OrientArea() > 0) {
+            _polygon.revertOrder();
+        }
+    }
+
+    void run(size_type slabs = 1) {
+        _compact();
+        if (_edges_changed)
+            _refresh_edge_events();
+        _answer_for_verticals();
+
+        slabs = std::min(slabs, _events.size() / min_slab_events);
+        if (slabs > 1)
+            _answer_for_others(slabs);
+        else
+            _answer_for_others();
+    }
+
+    void setEvents() {
+        GEOM_STATS_TIMER(EVENTS);
+        size_type id = 0;
+        for (auto e : _polygon.getEdges()) {
+            if (e.getPosition() != Geometry::Position::VERTICAL) {
+                _events.push_back(Event<T>(e.getId(), Event<T>::OPEN, e.minX()));
+                _events.push_back(Event<T>(e.getId(), Event<T>::CLOSE, e.maxX()));
+            }
+            id++;
+        }
+
+        Geometry::CellGrid<T> grid(_polygon.getEdges(), _inside_above, _polygon.getPoints(), _grid_cells);
+        _settled.assign(_query.size(), 0);
+        for (auto e : _query) {
+            Geometry::State state = grid.locate(e);
+            if (state != Geometry::State::BORDER) {
+                if (state == Geometry::State::INSIDE)
+                    _ans.set(e.getId(), state);
+                _settled[e.getId()] = 1;
+                GEOM_STATS_COUNT(PREFILTERED, 1);
+                continue;
+            }
+            _events.push_back(Event<T>(e.getId(), Event<T>::QUERY, e));
+        }
+        GEOM_STATS_COUNT(EVENT, _events.size());
+    }
+
+    // Queries outside the polygon's bounding box never become events. With
+    // cells > 0, setEvents() also lays a cells x cells grid over the box and
+    // answers the queries in cells no edge crosses (see Geometry::CellGrid);
+    // only the rest go through the sweep. Kept across reset().
+    void setGrid(size_type cells) {
+        _grid_cells = cells;
+    }
+
+    // Radix-sorts (x key, event index) pairs instead of the events themselves.
+    // Indices are laid out queries first, then closes, then opens, so the stable
+    // sort reproduces Event::operator< on equal x without putting the type in the key.
+    void sortEvents(size_type threads = 1) {
+        GEOM_STATS_TIMER(SORT);
+        std::vector<Geometry::RadixItem> &items = _items;
+        items.clear();
+        items.reserve(_events.size());
+        for (typename Event<T>::Type type : {Event<T>::QUERY, Event<T>::CLOSE, Event<T>::OPEN}) {
+            for (size_type i = 0; i < _events.size(); ++i) {
+                if (_events[i].getType() == type)
+                    items.push_back(Geometry::RadixItem{Geometry::radix_key(_events[i].getPoint().getX()),
+                                                        static_cast<uint32_t>(i)});
+            }
+        }
+
+        Geometry::parallel_radix_sort(items, threads);
+
+        _sorted.clear();
+        _sorted.reserve(_events.size());
+        for (const Geometry::RadixItem &item : items)
+            _sorted.push_back(_events[item.index]);
+        _events.swap(_sorted);
+    }
+
+    void setEdges() {
+        GEOM_STATS_TIMER(EDGES);
+        _polygon.setEdges();
+        _classify();
+    }
+
+    // Polygon edits after run() (see AdvancedPolygon::moveVertex and friends).
+    // Only the queries in the returned x-range are answered again; the edge
+    // events are brought up to date lazily by the next full run().
+    Geometry::Span<coordinate> moveVertex(size_type i, const value &p) {
+        Geometry::Span<coordinate> span = _polygon.moveVertex(i, p);
+        _resweep(span);
+        return span;
+    }
+
+    Geometry::Span<coordinate> insertVertex(size_type i, const value &p) {
+        Geometry::Span<coordinate> span = _polygon.insertVertex(i, p);
+        _resweep(span);
+        return span;
+    }
+
+    Geometry::Span<coordinate> eraseVertex(size_type i) {
+        Geometry::Span<coordinate> span = _polygon.eraseVertex(i);
+        _resweep(span);
+        return span;
+    }
+
+    const Geometry::AdvancedPolygon<T>& polygon() const {
+        return _polygon;
+    }
+
+    void reserve_query(size_type size) {
+        _query.reserve(size);
+        _ans.resize(size);
+    }
+
+    template <class U>
+    void push_query(U&& p) {
+        if (_polygon.isVertex(p)) {
+            _ans.set(p.getId(), Geometry::State::BORDER);
+            GEOM_STATS_COUNT(VERTEX_HIT, 1);
+        }
+
+        _query.push_back(std::forward<T>(p));
+    }
+
+    // Adds a query after the events are set up and returns its id. The query is
+    // answered by the next update(), or by run() like any other.
+    size_type insert_query(value p) {
+        size_type id = _query.size();
+        p.setId(id);
+        _ans.resize(id + 1);
+        push_query(p);
+        _erased.resize(_query.size());
+        _pending.push_back(Event<T>(id, Event<T>::QUERY, p));
+        return id;
+    }
+
+    // Removes a query; its id is not reused and its answer reads OUTSIDE.
+    void erase_query(size_type id) {
+        _erased.resize(_query.size());
+        if (_erased[id])
+            return;
+        _erased[id] = 1;
+        _ans.set(id, Geometry::State::OUTSIDE);
+        ++_stale;
+    }
+
+    // Answers the queries inserted since the last run() or update() without a
+    // new sweep: each is located in a PolygonIndex built once over the edges,
+    // so k changes cost O(k log n). The events are compacted only when the
+    // changes reach a quarter of them, keeping a later run() exact and cheap.
+    // Needs setEdges(); the index is dropped by reset() and clear().
+    void update() {
+        _erased.resize(_query.size());
+        if (!_index)
+            _index.reset(new Geometry::PolygonIndex<T>(_polygon.getEdges(), _inside_above, _polygon.getPoints()));
+
+        for (; _located < _pending.size(); ++_located) {
+            const Event<T> &e = _pending[_located];
+            if (!_erased[e.getId()])
+                _ans.set(e.getId(), _index->locate(e.getPoint()));
+        }
+        if ((_pending.size() + _stale) * compact_divisor >= _events.size())
+            _compact();
+    }
+
+    bool erased(size_type id) const {
+        return id < _erased.size() && _erased[id];
+    }
+
+    const_reference query(size_type id) const {
+        return _query[id];
+    }
+
+    void clear() {
+        _index.reset();
+        _pending.clear();
+        _erased.clear();
+        _located = 0;
+        _stale = 0;
+        _edges_changed = false;
+        _open.clear();
+        _edit_open.clear();
+        _query.clear();
+        _ans.clear();
+        _events.clear();
+        _settled.clear();
+    }
+
+    const Geometry::Answers& ans() const {
+        return _ans;
+    }
+
+    // Hands the answers over without copying; the engine is left empty until the next reset().
+    Geometry::Answers take_ans() {
+        return std::move(_ans);
+    }
+};
+
+
+#endif //GEOM_BELONGING_H
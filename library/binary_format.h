@@ -0,0 +1,260 @@
+#ifndef GEOM_BINARY_FORMAT_H
+#define GEOM_BINARY_FORMAT_H
+
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <type_traits>
+#include <vector>
+
+#include "answers.h"
+#include "geometry.h"
+
+// Versioned binary formats for batch jobs. Every field is 8 bytes wide and
+// little-endian, so a mapped file can be read in place without parsing.
+//
+// Tests:   "GEOMTST\0" | u32 version | u32 coordinates (0 = float64, 1 = int64)
+//          | u64 tests | per test: u64 n, n x, n y, u64 m, m x, m y
+// Answers: "GEOMANS\0" | u32 version | u32 reserved
+//          | per test until end of file: u64 m, ceil(m / 32) u64 words holding
+//          2-bit State codes, answer i in bits 2 (i % 32) of word i / 32
+namespace IO {
+    namespace Binary {
+        static const char tests_magic[8] = {'G', 'E', 'O', 'M', 'T', 'S', 'T', '\0'};
+        static const char answers_magic[8] = {'G', 'E', 'O', 'M', 'A', 'N', 'S', '\0'};
+        static const uint32_t version = 1;
+
+        enum Coordinates : uint32_t {
+            FLOAT64 = 0,
+            INT64 = 1,
+        };
+
+        inline uint64_t load(const char *p) {
+            uint64_t v;
+            std::memcpy(&v, p, sizeof(v));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+            v = __builtin_bswap64(v);
+#endif
+            return v;
+        }
+
+        inline uint32_t load32(const char *p) {
+            uint32_t v;
+            std::memcpy(&v, p, sizeof(v));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+            v = __builtin_bswap32(v);
+#endif
+            return v;
+        }
+
+        inline void store(std::ostream &os, uint64_t v) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+            v = __builtin_bswap64(v);
+#endif
+            os.write(reinterpret_cast<const char*>(&v), sizeof(v));
+        }
+
+        inline void store32(std::ostream &os, uint32_t v) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+            v = __builtin_bswap32(v);
+#endif
+            os.write(reinterpret_cast<const char*>(&v), sizeof(v));
+        }
+
+        template <class C>
+        uint64_t encode(C c, Coordinates coordinates) {
+            if (coordinates == INT64)
+                return static_cast<uint64_t>(static_cast<int64_t>(c));
+            double d = static_cast<double>(c);
+            uint64_t bits;
+            std::memcpy(&bits, &d, sizeof(bits));
+            return bits;
+        }
+
+        template <class C>
+        C decode(uint64_t bits, Coordinates coordinates) {
+            if (coordinates == INT64)
+                return static_cast<C>(static_cast<int64_t>(bits));
+            double d;
+            std::memcpy(&d, &bits, sizeof(d));
+            return static_cast<C>(d);
+        }
+
+        // Answer file words are filled 32 answers at a time.
+        inline size_t words(size_t m) {
+            return (m + 31) / 32;
+        }
+    }
+
+    // Reads the tests format from memory. Like Scanner it offers operator>> for
+    // counts, so the solve loops work unchanged; points come a column pair at a
+    // time through read(). A bad header or a truncated file sets the fail state.
+    class BinaryReader {
+    private:
+        using size_type = size_t;
+
+        const char *_cur, *_end;
+        Binary::Coordinates _coordinates = Binary::FLOAT64;
+        bool _fail = false;
+
+        bool _need(size_type bytes) {
+            if (_fail || static_cast<size_type>(_end - _cur) < bytes)
+                _fail = true;
+            return !_fail;
+        }
+    public:
+        BinaryReader(const char *begin, const char *end) : _cur(begin), _end(end) {
+            if (!_need(16) || std::memcmp(_cur, Binary::tests_magic, 8) != 0 ||
+                Binary::load32(_cur + 8) != Binary::version || Binary::load32(_cur + 12) > Binary::INT64) {
+                _fail = true;
+                return;
+            }
+            _coordinates = static_cast<Binary::Coordinates>(Binary::load32(_cur + 12));
+            _cur += 16;
+        }
+
+        explicit operator bool() const {
+            return !_fail;
+        }
+
+        Binary::Coordinates coordinates() const {
+            return _coordinates;
+        }
+
+        template <class U>
+        typename std::enable_if<std::is_integral<U>::value, BinaryReader&>::type operator>>(U &value) {
+            value = U();
+            if (_need(8)) {
+                value = static_cast<U>(Binary::load(_cur));
+                _cur += 8;
+            }
+            return *this;
+        }
+
+        // Reads n points stored as an x column followed by a y column; ids are 0..n-1.
+        template <class P>
+        void read(size_type n, Geometry::Points<P> &out) {
+            using coordinate = decltype(std::declval<const P&>().getX());
+
+            out.clear();
+            if (_fail || n > static_cast<size_type>(_end - _cur) / 16) {
+                _fail = true;
+                return;
+            }
+
+            out.reserve(n);
+            const char *xs = _cur, *ys = _cur + 8 * n;
+            for (size_type i = 0; i < n; ++i) {
+                out.push_back(P(Binary::decode<coordinate>(Binary::load(xs + 8 * i), _coordinates),
+                                Binary::decode<coordinate>(Binary::load(ys + 8 * i), _coordinates), i));
+            }
+            _cur += 16 * n;
+        }
+    };
+
+    // Writes the tests format; used by the converter.
+    class BinaryWriter {
+    private:
+        std::ostream &_os;
+        Binary::Coordinates _coordinates;
+    public:
+        BinaryWriter(std::ostream &os, Binary::Coordinates coordinates, uint64_t tests) :
+                _os(os), _coordinates(coordinates) {
+            _os.write(Binary::tests_magic, 8);
+            Binary::store32(_os, Binary::version);
+            Binary::store32(_os, coordinates);
+            Binary::store(_os, tests);
+        }
+
+        template <class Container>
+        void write(const Container &points) {
+            Binary::store(_os, points.size());
+            for (const auto &p : points)
+                Binary::store(_os, Binary::encode(p.getX(), _coordinates));
+            for (const auto &p : points)
+                Binary::store(_os, Binary::encode(p.getY(), _coordinates));
+        }
+    };
+
+    // Writes the answers format, one record per test.
+    class AnswerWriter {
+    private:
+        std::ostream &_os;
+    public:
+        explicit AnswerWriter(std::ostream &os) : _os(os) {
+            _os.write(Binary::answers_magic, 8);
+            Binary::store32(_os, Binary::version);
+            Binary::store32(_os, 0);
+        }
+
+        void write(const std::vector<Geometry::State> &answers) {
+            write(Geometry::Answers(answers));
+        }
+
+        // Answers are already packed in the file's layout, so this is one bulk write.
+        void write(const Geometry::Answers &answers) {
+            Binary::store(_os, answers.size());
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+            for (size_t i = 0; i < answers.word_count(); ++i)
+                Binary::store(_os, answers.words()[i]);
+#else
+            _os.write(reinterpret_cast<const char*>(answers.words()), 8 * answers.word_count());
+#endif
+        }
+    };
+
+    // Reads the answers format back; used by the converter.
+    class AnswerReader {
+    private:
+        const char *_cur, *_end;
+        bool _fail = false;
+    public:
+        AnswerReader(const char *begin, const char *end) : _cur(begin), _end(end) {
+            if (_end - _cur < 16 || std::memcmp(_cur, Binary::answers_magic, 8) != 0 ||
+                Binary::load32(_cur + 8) != Binary::version) {
+                _fail = true;
+                return;
+            }
+            _cur += 16;
+        }
+
+        explicit operator bool() const {
+            return !_fail;
+        }
+
+        bool done() const {
+            return _fail || _cur == _end;
+        }
+
+        bool failed() const {
+            return _fail;
+        }
+
+        // Reads the next test's answers; false at end of file or on a truncated record.
+        bool read(std::vector<Geometry::State> &answers) {
+            answers.clear();
+            if (done())
+                return false;
+            if (_end - _cur < 8) {
+                _fail = true;
+                return false;
+            }
+
+            uint64_t m = Binary::load(_cur);
+            if (Binary::words(m) > static_cast<uint64_t>(_end - _cur - 8) / 8) {
+                _fail = true;
+                return false;
+            }
+            _cur += 8;
+
+            answers.reserve(m);
+            for (uint64_t i = 0; i < m; ++i)
+                answers.push_back(static_cast<Geometry::State>((Binary::load(_cur + 8 * (i / 32)) >> (2 * (i % 32))) & 3));
+            _cur += 8 * Binary::words(m);
+            return true;
+        }
+    };
+}
+
+
+#endif //GEOM_BINARY_FORMAT_H
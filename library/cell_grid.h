@@ -0,0 +1,156 @@
+#ifndef GEOM_CELL_GRID_H
+#define GEOM_CELL_GRID_H
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "geometry.h"
+#include "polygon_index.h"
+
+namespace Geometry {
+    // Prefilter in front of a sweep. Queries outside the bounding box of the
+    // polygon are OUTSIDE; with cells > 0, a cells x cells grid over the box
+    // also answers queries in cells that no edge can pass through. Such cells
+    // lie wholly on one side of the boundary, and so do neighbouring ones (an
+    // edge between them would pass through one of them), so one point location
+    // settles a whole connected group. locate() returns BORDER for "not
+    // settled here".
+    template <class T>
+    class CellGrid {
+    private:
+        using value = T;
+        using size_type = size_t;
+        using coordinate = decltype(std::declval<const T&>().getX());
+
+        coordinate _min_x, _min_y, _max_x, _max_y;
+        size_type _cells = 0;
+        long double _scale_x = 0, _scale_y = 0;
+        std::vector<uint8_t> _state;
+        bool _empty = true;
+
+        static const uint8_t unknown = 3;
+
+        size_type _column(long double x) const {
+            long double c = (x - _min_x) * _scale_x;
+            return c <= 0 ? 0 : std::min(_cells - 1, static_cast<size_type>(c));
+        }
+
+        size_type _row(long double y) const {
+            long double r = (y - _min_y) * _scale_y;
+            return r <= 0 ? 0 : std::min(_cells - 1, static_cast<size_type>(r));
+        }
+
+        // Marks every cell the edge may touch, one column at a time, widened by
+        // a cell on each side so rounding in _column and _row cannot miss one.
+        void _mark(const Edge<value> &e) {
+            long double x0 = e.minX().getX(), y0 = e.minX().getY();
+            long double x1 = e.maxX().getX(), y1 = e.maxX().getY();
+            size_type first = _column(x0), last = _column(x1);
+            first = (first == 0 ? 0 : first - 1);
+            last = std::min(_cells - 1, last + 1);
+
+            for (size_type c = first; c <= last; ++c) {
+                long double left = std::max(x0, _min_x + c / _scale_x);
+                long double right = std::min(x1, _min_x + (c + 1) / _scale_x);
+                long double low, high;
+                if (x0 == x1) {
+                    low = std::min(y0, y1);
+                    high = std::max(y0, y1);
+                } else {
+                    left = std::min(left, x1);
+                    right = std::max(right, x0);
+                    long double a = y0 + (y1 - y0) * (left - x0) / (x1 - x0);
+                    long double b = y0 + (y1 - y0) * (right - x0) / (x1 - x0);
+                    low = std::min(a, b);
+                    high = std::max(a, b);
+                }
+
+                size_type bottom = _row(low), top = _row(high);
+                bottom = (bottom == 0 ? 0 : bottom - 1);
+                top = std::min(_cells - 1, top + 1);
+                for (size_type r = bottom; r <= top; ++r)
+                    _state[r * _cells + c] = State::BORDER;
+            }
+        }
+
+        void _classify(const std::vector<Edge<value>> &edges, const std::vector<uint8_t> &inside_above,
+                       const Points<value> &points) {
+            _state.assign(_cells * _cells, static_cast<uint8_t>(unknown));
+            for (const Edge<value> &e : edges)
+                _mark(e);
+
+            PolygonIndex<value> index(edges, inside_above, points);
+            std::vector<size_type> stack;
+            for (size_type cell = 0; cell < _state.size(); ++cell) {
+                if (_state[cell] != unknown)
+                    continue;
+
+                // Integer coordinates round the centre, which may leave a thin cell.
+                size_type r = cell / _cells, c = cell % _cells;
+                value centre(static_cast<coordinate>(_min_x + (c + 0.5L) / _scale_x),
+                             static_cast<coordinate>(_min_y + (r + 0.5L) / _scale_y), 0);
+                State state = State::BORDER;
+                if (_column(centre.getX()) == c && _row(centre.getY()) == r)
+                    state = index.locate(centre);
+                _state[cell] = state;
+                if (state == State::BORDER)
+                    continue;
+
+                stack.push_back(cell);
+                while (!stack.empty()) {
+                    size_type k = stack.back();
+                    stack.pop_back();
+                    size_type kr = k / _cells, kc = k % _cells;
+                    for (size_type next : {kc > 0 ? k - 1 : k, kc + 1 < _cells ? k + 1 : k,
+                                           kr > 0 ? k - _cells : k, kr + 1 < _cells ? k + _cells : k}) {
+                        if (_state[next] == unknown) {
+                            _state[next] = state;
+                            stack.push_back(next);
+                        }
+                    }
+                }
+            }
+        }
+    public:
+        CellGrid() = default;
+
+        CellGrid(const std::vector<Edge<value>> &edges, const std::vector<uint8_t> &inside_above,
+                 const Points<value> &points, size_type cells) {
+            if (points.empty())
+                return;
+
+            _empty = false;
+            _min_x = _max_x = points[0].getX();
+            _min_y = _max_y = points[0].getY();
+            for (const value &p : points) {
+                _min_x = std::min(_min_x, p.getX());
+                _max_x = std::max(_max_x, p.getX());
+                _min_y = std::min(_min_y, p.getY());
+                _max_y = std::max(_max_y, p.getY());
+            }
+            if (cells == 0 || _max_x == _min_x || _max_y == _min_y)
+                return;
+
+            _cells = cells;
+            _scale_x = cells / (static_cast<long double>(_max_x) - _min_x);
+            _scale_y = cells / (static_cast<long double>(_max_y) - _min_y);
+            _classify(edges, inside_above, points);
+        }
+
+        State locate(const value &p) const {
+            if (_empty || p.getX() < _min_x || p.getX() > _max_x || p.getY() < _min_y || p.getY() > _max_y)
+                return State::OUTSIDE;
+            if (_cells == 0)
+                return State::BORDER;
+            return static_cast<State>(_state[_row(p.getY()) * _cells + _column(p.getX())]);
+        }
+
+        size_type cells() const {
+            return _cells;
+        }
+    };
+}
+
+
+#endif //GEOM_CELL_GRID_H
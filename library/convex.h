@@ -0,0 +1,153 @@
+#ifndef GEOM_CONVEX_H
+#define GEOM_CONVEX_H
+
+#include <algorithm>
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "answers.h"
+#include "geometry.h"
+
+namespace Geometry {
+    // Point location in a convex polygon (see Geometry::convex) without events
+    // or a status. The polygon is cut into a fan of wedges around one vertex;
+    // a query finds its wedge by binary search on the turn direction and then
+    // checks the single outer edge of it. O(log n) per query, and the queries
+    // are independent, so they can be answered online or from several threads.
+    // The wedge rays are kept as offsets from the pivot in Eytzinger (BFS)
+    // order, so the top of the search shares cache lines across queries.
+    template <class T>
+    class ConvexWedges {
+    private:
+        using value = T;
+        using reference = T&;
+        using const_reference = const T&;
+        using pointer = T*;
+        using size_type = size_t;
+        using coordinate = decltype(std::declval<const T&>().getX());
+
+        struct Ray {
+            coordinate dx, dy;
+        };
+
+        // Counter-clockwise, without repeated or collinear vertices, starting
+        // at the lexicographically smallest one.
+        std::vector<value> _fan;
+        // Node k of the search tree (1-based) is the ray to _fan[_vertex[k]].
+        std::vector<Ray> _rays;
+        std::vector<uint32_t> _vertex;
+
+        // Same sign as turn(o, o + r, o + (dx, dy)).
+        static int _side(const Ray &r, coordinate dx, coordinate dy, std::false_type) {
+            long double cross = (long double)r.dx * dy - (long double)r.dy * dx;
+            return (cross > 0) - (cross < 0);
+        }
+
+        static int _side(const Ray &r, coordinate dx, coordinate dy, std::true_type) {
+            __int128 cross = (__int128)r.dx * dy - (__int128)r.dy * dx;
+            return (cross > 0) - (cross < 0);
+        }
+
+        static int _side(const Ray &r, coordinate dx, coordinate dy) {
+            return _side(r, dx, dy, std::is_integral<coordinate>());
+        }
+
+        // Lays the rays to _fan[1, k - 1) out in Eytzinger order by an in-order walk.
+        size_type _layout(size_type node, size_type next) {
+            if (node >= _rays.size())
+                return next;
+            next = _layout(2 * node, next);
+            _rays[node] = Ray{_fan[next].getX() - _fan[0].getX(), _fan[next].getY() - _fan[0].getY()};
+            _vertex[node] = next;
+            return _layout(2 * node + 1, next + 1);
+        }
+    public:
+        explicit ConvexWedges(const Points<value> &points) {
+            std::vector<value> ring;
+            for (size_type i = 0; i < points.size(); ++i) {
+                value p = points[i];
+                if (ring.empty() || !(ring.back() == p))
+                    ring.push_back(p);
+            }
+            while (ring.size() > 1 && ring.back() == ring.front())
+                ring.pop_back();
+
+            long double area = 0;
+            for (size_type i = 0; i < ring.size(); ++i)
+                area += ring[i] ^ ring[(i + 1) % ring.size()];
+            if (area < 0)
+                std::reverse(ring.begin(), ring.end());
+
+            for (size_type i = 0; i < ring.size(); ++i) {
+                const_reference prev = ring[(i + ring.size() - 1) % ring.size()];
+                if (turn(prev, ring[i], ring[(i + 1) % ring.size()]) != 0)
+                    _fan.push_back(ring[i]);
+            }
+            std::rotate(_fan.begin(), std::min_element(_fan.begin(), _fan.end(), LexicographicLess<value>()),
+                        _fan.end());
+
+            _rays.resize(_fan.size() - 1);
+            _vertex.resize(_fan.size() - 1);
+            _layout(1, 1);
+        }
+
+        State locate(const_reference q) const {
+            size_type k = _fan.size();
+            const_reference o = _fan[0];
+            int first = turn(o, _fan[1], q), last = turn(o, _fan[k - 1], q);
+            if (first < 0 || last > 0)
+                return State::OUTSIDE;
+
+            // The first ray q is right of ends the wedge; when there is none
+            // it is the last wedge.
+            coordinate dx = q.getX() - o.getX(), dy = q.getY() - o.getY();
+            size_type node = 1;
+            while (node < _rays.size())
+                node = 2 * node + (_side(_rays[node], dx, dy) >= 0);
+            node >>= __builtin_ffsll(~node);
+            size_type low = (node == 0 ? k - 2 : _vertex[node] - 1);
+
+            int outer = turn(_fan[low], _fan[low + 1], q);
+            if (outer < 0)
+                return State::OUTSIDE;
+            // On the outer edge, or on one of the two fan edges that are polygon edges.
+            if (outer == 0 || first == 0 || last == 0)
+                return State::BORDER;
+            return State::INSIDE;
+        }
+
+        // Answers all queries, split over threads in runs of 32 so that no two
+        // threads write the same answer word. Each thread gets at least 2^14
+        // queries, below which starting it costs more than it saves.
+        template <class Queries>
+        Answers run(const Queries &queries, size_type threads = 1) const {
+            Answers ans(queries.size());
+            size_type words = (queries.size() + 31) / 32;
+            threads = std::max<size_type>(std::min(threads, queries.size() >> 14), 1);
+
+            auto work = [this, &queries, &ans](size_type begin, size_type end) {
+                for (size_type i = begin; i < end; ++i)
+                    ans.set(i, locate(queries[i]));
+            };
+            std::vector<std::thread> workers;
+            for (size_type t = 1; t < threads; ++t) {
+                size_type begin = std::min(32 * (words * t / threads), queries.size());
+                size_type end = std::min(32 * (words * (t + 1) / threads), queries.size());
+                workers.emplace_back(work, begin, end);
+            }
+            work(0, std::min(32 * (words / threads), queries.size()));
+            for (std::thread &t : workers)
+                t.join();
+            return ans;
+        }
+
+        size_type size() const {
+            return _fan.size();
+        }
+    };
+}
+
+
+#endif //GEOM_CONVEX_H
@@ -0,0 +1,103 @@
+#ifndef GEOM_EXECUTOR_H
+#define GEOM_EXECUTOR_H
+
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+namespace Parallel {
+    inline size_t hardware_threads() {
+        size_t threads = std::thread::hardware_concurrency();
+        return threads == 0 ? 1 : threads;
+    }
+
+    // Runs independent weighted tasks on a fixed set of threads. Tasks are dealt
+    // heaviest-first to the least loaded worker; a worker that runs dry steals
+    // the lightest task left on another worker's deque.
+    class WorkStealingExecutor {
+    private:
+        using size_type = size_t;
+
+        struct Worker {
+            std::mutex lock;
+            std::deque<size_type> tasks;
+        };
+
+        size_type _threads;
+
+        static bool _pop(Worker &worker, size_type &task) {
+            std::lock_guard<std::mutex> guard(worker.lock);
+            if (worker.tasks.empty())
+                return false;
+            task = worker.tasks.front();
+            worker.tasks.pop_front();
+            return true;
+        }
+
+        static bool _steal(Worker &worker, size_type &task) {
+            std::lock_guard<std::mutex> guard(worker.lock);
+            if (worker.tasks.empty())
+                return false;
+            task = worker.tasks.back();
+            worker.tasks.pop_back();
+            return true;
+        }
+
+        template <class Task>
+        static void _work(std::vector<Worker> &workers, size_type self, Task &task) {
+            size_type index;
+            while (true) {
+                if (_pop(workers[self], index)) {
+                    task(index);
+                    continue;
+                }
+
+                bool stolen = false;
+                for (size_type i = 1; i < workers.size() && !stolen; ++i) {
+                    stolen = _steal(workers[(self + i) % workers.size()], index);
+                }
+                if (!stolen)
+                    return;
+                task(index);
+            }
+        }
+    public:
+        explicit WorkStealingExecutor(size_type threads = hardware_threads()) : _threads(std::max<size_type>(threads, 1)) {}
+
+        size_type threads() const {
+            return _threads;
+        }
+
+        template <class Task>
+        void run(const std::vector<size_type> &weights, Task task) {
+            std::vector<size_type> order(weights.size());
+            std::iota(order.begin(), order.end(), 0);
+            std::stable_sort(order.begin(), order.end(), [&weights](size_type a, size_type b) {
+                return weights[a] > weights[b];
+            });
+
+            size_type threads = std::min(_threads, std::max<size_type>(weights.size(), 1));
+            std::vector<Worker> workers(threads);
+            std::vector<size_type> load(threads, 0);
+            for (size_type index : order) {
+                size_type target = std::min_element(load.begin(), load.end()) - load.begin();
+                load[target] += weights[index] + 1;
+                workers[target].tasks.push_back(index);
+            }
+
+            std::vector<std::thread> pool;
+            for (size_type i = 1; i < threads; ++i)
+                pool.emplace_back([&workers, &task, i]() { _work(workers, i, task); });
+
+            _work(workers, 0, task);
+            for (std::thread &t : pool)
+                t.join();
+        }
+    };
+}
+
+
+#endif //GEOM_EXECUTOR_H
@@ -3,9 +3,15 @@
 
 #include <iostream>
 #include <vector>
-#include <set>
 #include <map>
 #include <functional>
+#include <algorithm>
+#include <utility>
+#include <iterator>
+
+#include "arena.h"
+#include "stats.h"
+#include "vertex_set.h"
 
 namespace Geometry {
     enum Position {
@@ -20,6 +26,18 @@ namespace Geometry {
         BORDER,
     };
 
+    // A closed range of x, e.g. the strip of the plane a polygon edit can affect.
+    template <class C>
+    struct Span {
+        C low, high;
+    };
+
+    // How overlapping rings of one polygon combine.
+    enum FillRule {
+        EVEN_ODD,
+        NONZERO,
+    };
+
     template <class T>
     class Point {
     private:
@@ -53,7 +71,7 @@ namespace Geometry {
         }
 
         long double operator^(const Point<value> &p) const {
-            return _x * p._y - _y * p._x;
+            return (long double)_x * p._y - (long double)_y * p._x;
         }
 
         friend std::ostream& operator<<(std::ostream &os, const Point<value> &p) {
@@ -71,6 +89,277 @@ namespace Geometry {
         }
     };
 
+    // A Point whose containers store coordinates column-wise (see PointColumns).
+    template <class T>
+    class ColumnPoint : public Point<T> {
+    public:
+        using Point<T>::Point;
+
+        ColumnPoint() = default;
+
+        ColumnPoint(const Point<T> &p) : Point<T>(p) {}
+    };
+
+    // Struct-of-arrays container for points: x, y and id live in separate arrays
+    // so that coordinate scans touch only the bytes they need. Elements are read
+    // by value; it offers the subset of std::vector the algorithms rely on.
+    template <class T>
+    class PointColumns {
+    private:
+        using value = T;
+        using size_type = size_t;
+        using coordinate = decltype(std::declval<const T&>().getX());
+
+        std::vector<coordinate> _x, _y;
+        std::vector<size_type> _id;
+    public:
+        class const_iterator {
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const T*;
+            using reference = T;
+        private:
+            const PointColumns *_owner;
+            size_type _index;
+        public:
+            const_iterator(const PointColumns *owner, size_type index) : _owner(owner), _index(index) {}
+
+            value operator*() const {
+                return (*_owner)[_index];
+            }
+
+            const_iterator& operator++() {
+                ++_index;
+                return *this;
+            }
+
+            bool operator==(const const_iterator &other) const {
+                return _index == other._index;
+            }
+
+            bool operator!=(const const_iterator &other) const {
+                return _index != other._index;
+            }
+        };
+
+        PointColumns() = default;
+
+        PointColumns(const std::vector<value> &points) {
+            reserve(points.size());
+            for (const value &p : points)
+                push_back(p);
+        }
+
+        size_type size() const {
+            return _x.size();
+        }
+
+        bool empty() const {
+            return _x.empty();
+        }
+
+        void reserve(size_type size) {
+            _x.reserve(size);
+            _y.reserve(size);
+            _id.reserve(size);
+        }
+
+        void push_back(const value &p) {
+            _x.push_back(p.getX());
+            _y.push_back(p.getY());
+            _id.push_back(p.getId());
+        }
+
+        void clear() {
+            _x.clear();
+            _y.clear();
+            _id.clear();
+        }
+
+        void reverse() {
+            reverse(0, size());
+        }
+
+        void reverse(size_type first, size_type last) {
+            std::reverse(_x.begin() + first, _x.begin() + last);
+            std::reverse(_y.begin() + first, _y.begin() + last);
+            std::reverse(_id.begin() + first, _id.begin() + last);
+        }
+
+        value operator[](size_type index) const {
+            return value(_x[index], _y[index], _id[index]);
+        }
+
+        // Writes go through these, as operator[] returns a copy.
+        void set(size_type index, const value &p) {
+            _x[index] = p.getX();
+            _y[index] = p.getY();
+            _id[index] = p.getId();
+        }
+
+        void insert(size_type index, const value &p) {
+            _x.insert(_x.begin() + index, p.getX());
+            _y.insert(_y.begin() + index, p.getY());
+            _id.insert(_id.begin() + index, p.getId());
+        }
+
+        void erase(size_type index) {
+            _x.erase(_x.begin() + index);
+            _y.erase(_y.begin() + index);
+            _id.erase(_id.begin() + index);
+        }
+
+        const coordinate* x() const {
+            return _x.data();
+        }
+
+        const coordinate* y() const {
+            return _y.data();
+        }
+
+        const size_type* id() const {
+            return _id.data();
+        }
+
+        const_iterator begin() const {
+            return const_iterator(this, 0);
+        }
+
+        const_iterator end() const {
+            return const_iterator(this, size());
+        }
+    };
+
+    // The container a point type is stored in: std::vector by default, columns for ColumnPoint.
+    template <class T>
+    struct PointStorage {
+        using type = std::vector<T>;
+    };
+
+    template <class T>
+    struct PointStorage<ColumnPoint<T>> {
+        using type = PointColumns<ColumnPoint<T>>;
+    };
+
+    template <class T>
+    using Points = typename PointStorage<T>::type;
+
+    template <class T>
+    void reverse(std::vector<T> &points) {
+        std::reverse(points.begin(), points.end());
+    }
+
+    template <class T>
+    void reverse(PointColumns<T> &points) {
+        points.reverse();
+    }
+
+    template <class T>
+    void reverse(std::vector<T> &points, size_t first, size_t last) {
+        std::reverse(points.begin() + first, points.begin() + last);
+    }
+
+    template <class T>
+    void reverse(PointColumns<T> &points, size_t first, size_t last) {
+        points.reverse(first, last);
+    }
+
+    template <class T>
+    void set_point(std::vector<T> &points, size_t index, const T &p) {
+        points[index] = p;
+    }
+
+    template <class T>
+    void set_point(PointColumns<T> &points, size_t index, const T &p) {
+        points.set(index, p);
+    }
+
+    template <class T>
+    void insert_point(std::vector<T> &points, size_t index, const T &p) {
+        points.insert(points.begin() + index, p);
+    }
+
+    template <class T>
+    void insert_point(PointColumns<T> &points, size_t index, const T &p) {
+        points.insert(index, p);
+    }
+
+    template <class T>
+    void erase_point(std::vector<T> &points, size_t index) {
+        points.erase(points.begin() + index);
+    }
+
+    template <class T>
+    void erase_point(PointColumns<T> &points, size_t index) {
+        points.erase(index);
+    }
+
+    namespace Detail {
+        template <class T>
+        int turn(const T &a, const T &b, const T &c, std::false_type) {
+            long double cross = T(b.getX() - a.getX(), b.getY() - a.getY(), 0) ^
+                                T(c.getX() - a.getX(), c.getY() - a.getY(), 0);
+            return (cross > 0) - (cross < 0);
+        }
+
+        template <class T>
+        int turn(const T &a, const T &b, const T &c, std::true_type) {
+            __int128 cross = ((__int128)b.getX() - a.getX()) * ((__int128)c.getY() - a.getY()) -
+                             ((__int128)b.getY() - a.getY()) * ((__int128)c.getX() - a.getX());
+            return (cross > 0) - (cross < 0);
+        }
+    }
+
+    // Sign of (b - a) ^ (c - a): positive when a, b, c turn counter-clockwise.
+    // Exact for integer coordinates within +-2^40.
+    template <class T>
+    int turn(const T &a, const T &b, const T &c) {
+        return Detail::turn(a, b, c, std::is_integral<decltype(a.getX())>());
+    }
+
+    // Whether points[first, last) is a convex polygon, in one pass: the turns
+    // at the vertices never change sign (collinear and repeated vertices are
+    // allowed, reversals are not) and the edges go around only once, i.e. the
+    // sign of their dx changes at most twice.
+    template <class Points>
+    bool convex(const Points &points, size_t first, size_t last) {
+        size_t n = last - first;
+        if (n < 3)
+            return false;
+
+        int sign = 0, changes = 0, dx = 0;
+        for (size_t k = 0; k < n; ++k) {
+            auto a = points[first + k], b = points[first + (k + 1) % n], c = points[first + (k + 2) % n];
+            int t = turn(a, b, c);
+            if (t == 0) {
+                long double dot = ((long double)b.getX() - a.getX()) * ((long double)c.getX() - b.getX()) +
+                                  ((long double)b.getY() - a.getY()) * ((long double)c.getY() - b.getY());
+                if (dot < 0)
+                    return false;
+            } else if (sign == 0) {
+                sign = t;
+            } else if (t != sign) {
+                return false;
+            }
+
+            int d = (b.getX() > a.getX()) - (b.getX() < a.getX());
+            if (d != 0) {
+                changes += (dx != 0 && d != dx);
+                dx = d;
+            }
+        }
+        // Around the whole cycle the changes come in pairs, so at most two
+        // along the open sequence means at most two in all.
+        return sign != 0 && changes <= 2;
+    }
+
+    template <class Points>
+    bool convex(const Points &points) {
+        return convex(points, 0, points.size());
+    }
+
     template <class T>
     class Segment {
     protected:
@@ -79,8 +368,47 @@ namespace Geometry {
         using const_reference = const T&;
         using pointer = T*;
         using size_type = size_t;
+        using coordinate = decltype(std::declval<const T&>().getX());
 
         value _left, _right;
+
+        static int _sign(double d) {
+            return (d > 0) - (d < 0);
+        }
+
+        static int _sign(__int128 d) {
+            return (d > 0) - (d < 0);
+        }
+
+        int _side(const_reference p, std::false_type) const {
+            return _sign((double)p.getY() - y(p.getX()));
+        }
+
+        int _compare(const Segment &other, coordinate x, std::false_type) const {
+            double a = y(x), b = other.y(x);
+            return (a > b) - (a < b);
+        }
+
+        // Integer coordinates never divide: y(x) is kept as a fraction with the
+        // positive denominator dx and both sides are cross-multiplied in 128 bits.
+        // Exact while coordinates stay within +-2^40.
+        std::pair<__int128, __int128> _height(coordinate x) const {
+            const_reference l = minX(), r = maxX();
+            __int128 dx = (__int128)r.getX() - l.getX();
+            if (dx == 0)
+                return {(__int128)first().getY(), 1};
+            return {(__int128)l.getY() * dx + ((__int128)r.getY() - l.getY()) * ((__int128)x - l.getX()), dx};
+        }
+
+        int _side(const_reference p, std::true_type) const {
+            std::pair<__int128, __int128> h = _height(p.getX());
+            return _sign((__int128)p.getY() * h.second - h.first);
+        }
+
+        int _compare(const Segment &other, coordinate x, std::true_type) const {
+            std::pair<__int128, __int128> a = _height(x), b = other._height(x);
+            return _sign(a.first * b.second - b.first * a.second);
+        }
     public:
         Segment(const_reference &a, const_reference &b) : _left(a), _right(b) {}
 
@@ -116,6 +444,16 @@ namespace Geometry {
             return minX().getY() + (double)((maxX().getY() - minX().getY()) * (x - minX().getX()))
                                    / (maxX().getX() - minX().getX());
         }
+
+        // Sign of p.y - y(p.x): positive when p lies above the segment.
+        int side(const_reference p) const {
+            return _side(p, std::is_integral<coordinate>());
+        }
+
+        // Sign of y(x) - other.y(x).
+        int compare(const Segment &other, coordinate x) const {
+            return _compare(other, x, std::is_integral<coordinate>());
+        }
     };
 
     template<class T>
@@ -140,6 +478,10 @@ namespace Geometry {
             return _id;
         }
 
+        void setId(size_type id) {
+            _id = id;
+        }
+
         void setPosition(Position position) {
             _position = position;
         }
@@ -149,6 +491,30 @@ namespace Geometry {
         }
     };
 
+    // Vertical order of two edges over the x-range they share; used by every sweep status.
+    template <class T>
+    struct EdgeLess {
+        bool operator()(const Edge<T> &a, const Edge<T> &b) const {
+            GEOM_STATS_COUNT(COMPARISON, 1);
+            auto min_x = std::max(a.minX().getX(), b.minX().getX());
+            auto max_x = std::min(a.maxX().getX(), b.maxX().getX());
+
+            int left = a.compare(b, min_x);
+            return (left < 0 || (left == 0 && a.compare(b, max_x) < 0));
+        }
+    };
+
+    // Points by x, then y. Stateless, so containers keyed with it inline every
+    // comparison instead of calling through a std::function.
+    template <class T>
+    struct LexicographicLess {
+        bool operator()(const T &a, const T &b) const {
+            if (a.getX() == b.getX()) {
+                return a.getY() < b.getY();
+            }
+            return a.getX() < b.getX();
+        }
+    };
 
     template <class T>
     class Polygon {
@@ -159,17 +525,17 @@ namespace Geometry {
         using pointer = T*;
         using size_type = size_t;
 
-        std::vector<value> _points;
+        Points<value> _points;
     public:
         Polygon() = default;
 
-        explicit Polygon(std::vector<value> _points) : _points(_points) {}
+        explicit Polygon(Points<value> _points) : _points(_points) {}
 
         void revertOrder() {
-            std::reverse(_points.begin(), _points.end());
+            Geometry::reverse(_points);
         }
 
-        const std::vector<value>& getPoints() const {
+        const Points<value>& getPoints() const {
             return _points;
         }
 
@@ -190,42 +556,261 @@ namespace Geometry {
         using pointer = T*;
         using size_type = size_t;
 
+        using coordinate = decltype(std::declval<const T&>().getX());
+        using vertical_map = Memory::ArenaMap<coordinate, Memory::ArenaVector<Edge<value>>>;
+
         std::vector<Edge<value>> _edges;
-        std::map<int, std::vector<Edge<value>>> _vertical_edges;
+        Memory::Arena *_arena;
+        vertical_map _vertical_edges;
 
-        std::function<bool(const T&, const T&)> cmp = [](const T& a, const T& b) {
-            if (a.getX() == b.getX()) {
-                return a.getY() < b.getY();
+        // First point of every ring; empty for the usual single ring. _windings
+        // holds +1 for rings given counter-clockwise, -1 otherwise (orientRings).
+        std::vector<size_type> _rings;
+        std::vector<int> _windings;
+
+        // Counts copies, so a repeated point stays a vertex until its last copy goes.
+        VertexSet<T> _vertex_set;
+
+        void _add_vertices(const Points<value> &points) {
+            _vertex_set.reserve(points.size());
+            for (auto p : points)
+                _vertex_set.insert(p);
+        }
+
+        void _add_vertex(const value &p) {
+            _vertex_set.insert(p);
+        }
+
+        void _remove_vertex(const value &p) {
+            _vertex_set.erase(p);
+        }
+
+        size_type _next(size_type i) const {
+            size_type r = ringOf(i);
+            return i + 1 == ringEnd(r) ? ringBegin(r) : i + 1;
+        }
+
+        size_type _prev(size_type i) const {
+            size_type r = ringOf(i);
+            return i == ringBegin(r) ? ringEnd(r) - 1 : i - 1;
+        }
+
+        Edge<value> _edge(size_type i) const {
+            const Points<value> &points = Polygon<T>::_points;
+            Edge<value> e(points[i], points[_next(i)], i);
+            if (e.first().getX() < e.second().getX()) {
+                e.setPosition(Geometry::Position::DOWN);
+            } else if (e.first().getX() == e.second().getX()) {
+                e.setPosition(Geometry::Position::VERTICAL);
+            } else {
+                e.setPosition(Geometry::Position::UP);
             }
-            return a.getX() < b.getX();
-        };
+            return e;
+        }
 
-        std::multiset<T, decltype(cmp)> _verticies;
-    public:
-        AdvancedPolygon() : _verticies(cmp) {};
+        void _add_vertical(const Edge<value> &e) {
+            if (e.getPosition() == Geometry::Position::VERTICAL)
+                _vertical_edges[e.first().getX()].push_back(e);
+        }
 
-        explicit AdvancedPolygon(std::vector<value> _points) : Polygon<T>(_points), _verticies(cmp) {
-            for (auto p : _points)
-                _verticies.insert(p);
+        void _remove_vertical(const Edge<value> &e) {
+            if (e.getPosition() != Geometry::Position::VERTICAL)
+                return;
+            auto bucket = _vertical_edges.find(e.first().getX());
+            auto &list = bucket->second;
+            list.erase(std::find_if(list.begin(), list.end(), [&e](const Edge<value> &v) {
+                return v.getId() == e.getId();
+            }));
+            if (list.empty())
+                _vertical_edges.erase(bucket);
         }
 
-        void setEdges() {
-            for (size_type i = 0; i < Polygon<T>::_points.size(); ++i) {
-                _edges.push_back(Geometry::Edge<T>(Polygon<T>::_points[i], Polygon<T>::_points[Polygon<T>::next_point(i)], i));
-                if (Polygon<T>::_points[i].getX() == Polygon<T>::_points[Polygon<T>::next_point(i)].getX()) {
-                    _vertical_edges[Polygon<T>::_points[i].getX()].push_back(_edges.back());
+        // Edge ids are their positions, so inserting or erasing point i moves
+        // every later edge, ring start and vertical bucket entry by delta.
+        void _shift(size_type i, int delta) {
+            for (size_type k = i; k < _edges.size(); ++k)
+                _edges[k].setId(k);
+            for (auto &bucket : _vertical_edges) {
+                for (Edge<value> &e : bucket.second) {
+                    if (e.getId() >= i)
+                        e.setId(e.getId() + delta);
                 }
+            }
+            for (size_type &start : _rings) {
+                if (start > i)
+                    start += delta;
+            }
+        }
+
+        // An arena never takes back what edits free, so the first edit moves
+        // the vertical buckets to the heap; clear() puts them back on the arena.
+        void _detach() {
+            if (_vertical_edges.get_allocator().arena() == nullptr)
+                return;
+            vertical_map heap{typename vertical_map::allocator_type(nullptr)};
+            for (const auto &bucket : _vertical_edges)
+                heap[bucket.first].assign(bucket.second.begin(), bucket.second.end());
+            _vertical_edges = std::move(heap);
+        }
+
+        Span<coordinate> _span(std::initializer_list<coordinate> xs) const {
+            return Span<coordinate>{std::min(xs), std::max(xs)};
+        }
+    public:
+        // Node-based members allocate from arena when one is given.
+        explicit AdvancedPolygon(Memory::Arena *arena = nullptr) :
+                _arena(arena), _vertical_edges(typename vertical_map::allocator_type(arena)) {};
+
+        explicit AdvancedPolygon(Points<value> _points, Memory::Arena *arena = nullptr) :
+                Polygon<T>(_points), _arena(arena), _vertical_edges(typename vertical_map::allocator_type(arena)) {
+            _add_vertices(_points);
+        }
+
+        // Drops points, edges and lookups but keeps the capacity of the flat arrays.
+        void clear() {
+            Polygon<T>::_points.clear();
+            _rings.clear();
+            _windings.clear();
+            _edges.clear();
+            _vertical_edges = vertical_map(typename vertical_map::allocator_type(_arena));
+            _vertex_set.clear();
+        }
+
+        void assign(const Points<value> &points) {
+            clear();
+            Polygon<T>::_points = points;
+            _add_vertices(points);
+        }
+
+        // Splits the points into rings starting at the given offsets (the first must be 0).
+        void setRings(const std::vector<size_type> &starts) {
+            _rings = starts;
+            _windings.clear();
+        }
+
+        size_type rings() const {
+            return _rings.empty() ? 1 : _rings.size();
+        }
+
+        size_type ringBegin(size_type ring) const {
+            return _rings.empty() ? 0 : _rings[ring];
+        }
+
+        size_type ringEnd(size_type ring) const {
+            return ring + 1 < _rings.size() ? _rings[ring + 1] : Polygon<T>::_points.size();
+        }
+
+        // The ring holding point (and edge) i.
+        size_type ringOf(size_type i) const {
+            if (_rings.empty())
+                return 0;
+            return std::upper_bound(_rings.begin(), _rings.end(), i) - _rings.begin() - 1;
+        }
 
-                if (_edges.back().first().getX() < _edges.back().second().getX()) {
-                    _edges.back().setPosition(Geometry::Position::DOWN);
-                } else if (_edges.back().first().getX() == _edges.back().second().getX()){
-                    _edges.back().setPosition(Geometry::Position::VERTICAL);
-                } else {
-                    _edges.back().setPosition(Geometry::Position::UP);
+        double ringArea(size_type ring) const {
+            double sq = 0;
+            for (size_type i = ringBegin(ring); i < ringEnd(ring); ++i) {
+                size_type j = (i + 1 == ringEnd(ring) ? ringBegin(ring) : i + 1);
+                sq += Polygon<T>::_points[i] ^ Polygon<T>::_points[j];
+            }
+            return sq;
+        }
+
+        // Turns every ring clockwise, remembering which way it was given.
+        void orientRings() {
+            _windings.assign(rings(), -1);
+            for (size_type r = 0; r < rings(); ++r) {
+                if (ringArea(r) > 0) {
+                    _windings[r] = 1;
+                    Geometry::reverse(Polygon<T>::_points, ringBegin(r), ringEnd(r));
                 }
             }
         }
 
+        int getWinding(size_type ring) const {
+            return _windings.empty() ? 1 : _windings[ring];
+        }
+
+        bool isConvex() const {
+            return rings() == 1 && convex(Polygon<T>::_points);
+        }
+
+        void setEdges() {
+            _edges.clear();
+            _vertical_edges.clear();
+            for (size_type i = 0; i < Polygon<T>::_points.size(); ++i) {
+                _edges.push_back(_edge(i));
+                _add_vertical(_edges.back());
+            }
+        }
+
+        // Edits after setEdges(). Edges, vertex lookups and vertical buckets
+        // are patched in place, and each edit returns the x-range outside of
+        // which no point changes state. The polygon must stay simple, keep its
+        // orientation and leave every ring at least three points.
+
+        // Moves point i to p.
+        Span<coordinate> moveVertex(size_type i, const value &p) {
+            _detach();
+            Points<value> &points = Polygon<T>::_points;
+            size_type prev = _prev(i);
+            Span<coordinate> span = _span({points[prev].getX(), points[i].getX(), p.getX(),
+                                           points[_next(i)].getX()});
+
+            _remove_vertical(_edges[prev]);
+            _remove_vertical(_edges[i]);
+            _remove_vertex(points[i]);
+            Geometry::set_point(points, i, p);
+            _add_vertex(p);
+            _edges[prev] = _edge(prev);
+            _edges[i] = _edge(i);
+            _add_vertical(_edges[prev]);
+            _add_vertical(_edges[i]);
+            return span;
+        }
+
+        // Inserts p as point i, on the edge between points i - 1 and i of the
+        // ring holding i (between its last and first point when i starts it).
+        Span<coordinate> insertVertex(size_type i, const value &p) {
+            _detach();
+            Points<value> &points = Polygon<T>::_points;
+            size_type prev = _prev(i);
+            Span<coordinate> span = _span({points[prev].getX(), p.getX(), points[i].getX()});
+
+            _remove_vertical(_edges[prev]);
+            Geometry::insert_point(points, i, p);
+            _edges.insert(_edges.begin() + i, Edge<value>(p, p, i));
+            _shift(i, 1);
+            _add_vertex(p);
+
+            prev = _prev(i);
+            _edges[prev] = _edge(prev);
+            _edges[i] = _edge(i);
+            _add_vertical(_edges[prev]);
+            _add_vertical(_edges[i]);
+            return span;
+        }
+
+        // Erases point i, joining its neighbours with one edge.
+        Span<coordinate> eraseVertex(size_type i) {
+            _detach();
+            Points<value> &points = Polygon<T>::_points;
+            size_type prev = _prev(i);
+            Span<coordinate> span = _span({points[prev].getX(), points[i].getX(), points[_next(i)].getX()});
+
+            _remove_vertical(_edges[prev]);
+            _remove_vertical(_edges[i]);
+            _remove_vertex(points[i]);
+            Geometry::erase_point(points, i);
+            _edges.erase(_edges.begin() + i);
+            _shift(i, -1);
+
+            prev = (prev > i ? prev - 1 : prev);
+            _edges[prev] = _edge(prev);
+            _add_vertical(_edges[prev]);
+            return span;
+        }
+
         double OrientArea() const {
             double sq = 0;
             for (size_type i = 0; i < Polygon<T>::_points.size(); ++i) {
@@ -234,11 +819,16 @@ namespace Geometry {
             return sq;
         }
 
-        const std::multiset<value, decltype(cmp)>& getVerticies() const {
-            return _verticies;
-        };
+        // Exact vertex test in expected O(1), used for every query.
+        bool isVertex(const value &p) const {
+            return _vertex_set.contains(p);
+        }
+
+        vertical_map& getVerticalEdges() {
+            return _vertical_edges;
+        }
 
-        std::map<int, std::vector<Edge<T>>>& getVerticalEdges() {
+        const vertical_map& getVerticalEdges() const {
             return _vertical_edges;
         }
 
@@ -0,0 +1,248 @@
+#ifndef GEOM_MULTI_POLYGON_H
+#define GEOM_MULTI_POLYGON_H
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "answers.h"
+#include "geometry.h"
+#include "radix_sort.h"
+#include "sweep_status.h"
+#include "vertex_set.h"
+
+// Locates one query set in many polygons with a single sweep. The queries and
+// the edges of every polygon are sorted together once; each polygon keeps its
+// own status, and a query is only tested against the polygons whose x-range
+// contains it (the active set) and whose y-range contains it. Answers are
+// collected sparsely, one entry per (query, polygon) pair that is not OUTSIDE.
+//
+// Every polygon is a single simple ring: a zone is inside exactly where the
+// nearest edge below runs upwards, which does not hold for holes or several
+// shells. Such polygons need MultiBelongingAlgorithm::setRings. An empty
+// polygon contains no query.
+template <class T, class Status = Geometry::BlockStatus<T>>
+class MultiPolygonAlgorithm {
+public:
+    struct Hit {
+        uint32_t query;
+        uint32_t polygon;
+        Geometry::State state;
+    };
+private:
+    using value = T;
+    using size_type = size_t;
+    using coordinate = decltype(std::declval<const T&>().getX());
+
+    enum Type : uint8_t {
+        QUERY,
+        CLOSE,
+        OPEN,
+    };
+
+    struct Event {
+        Type type;
+        uint32_t polygon;
+        uint32_t id;
+    };
+
+    struct Vertical {
+        coordinate x, low, high;
+    };
+
+    struct Zone {
+        Geometry::AdvancedPolygon<T> polygon;
+        Geometry::VertexSet<T> vertices;
+        std::vector<Vertical> verticals;
+        coordinate min_x = 0, max_x = 0, min_y = 0, max_y = 0;
+        Status open;
+
+        explicit Zone(const Geometry::Points<value> &points) : polygon(points), open(polygon.getEdges()) {
+            if (polygon.OrientArea() > 0)
+                polygon.revertOrder();
+            polygon.setEdges();
+
+            if (points.empty())
+                return;
+
+            vertices.reserve(points.size());
+            min_x = max_x = points[0].getX();
+            min_y = max_y = points[0].getY();
+            for (value p : points) {
+                vertices.insert(p);
+                min_x = std::min(min_x, p.getX());
+                max_x = std::max(max_x, p.getX());
+                min_y = std::min(min_y, p.getY());
+                max_y = std::max(max_y, p.getY());
+            }
+
+            for (const Geometry::Edge<T> &e : polygon.getEdges()) {
+                if (e.getPosition() == Geometry::Position::VERTICAL)
+                    verticals.push_back(Vertical{e.first().getX(), e.minY().getY(), e.maxY().getY()});
+            }
+            std::sort(verticals.begin(), verticals.end(), [](const Vertical &a, const Vertical &b) {
+                if (a.x == b.x) {
+                    return a.low < b.low;
+                }
+                return a.x < b.x;
+            });
+            for (size_type i = 1; i < verticals.size(); ++i) {
+                if (verticals[i].x == verticals[i - 1].x)
+                    verticals[i].high = std::max(verticals[i].high, verticals[i - 1].high);
+            }
+        }
+
+        // Same lookup as PolygonIndex: a running maximum of high within one x
+        // means only the last vertical starting at or below p matters.
+        bool onVertical(const value &p) const {
+            auto it = std::upper_bound(verticals.begin(), verticals.end(), p, [](const value &q, const Vertical &v) {
+                if (q.getX() == v.x) {
+                    return q.getY() < v.low;
+                }
+                return q.getX() < v.x;
+            });
+            return it != verticals.begin() && (it - 1)->x == p.getX() && (it - 1)->high >= p.getY();
+        }
+
+        Geometry::State locate(const value &p) const {
+            if (vertices.contains(p) || onVertical(p))
+                return Geometry::State::BORDER;
+            if (open.empty())
+                return Geometry::State::OUTSIDE;
+
+            const std::vector<Geometry::Edge<T>> &edges = polygon.getEdges();
+            std::pair<ssize_t, ssize_t> around = open.locate(p);
+            if (around.second >= 0 && edges[around.second].side(p) == 0)
+                return Geometry::State::BORDER;
+            if (around.first >= 0 && edges[around.first].getPosition() == Geometry::Position::UP)
+                return Geometry::State::INSIDE;
+            return Geometry::State::OUTSIDE;
+        }
+    };
+
+    // Zones are referenced by their statuses, so they must not move.
+    std::vector<std::unique_ptr<Zone>> _zones;
+    Geometry::Points<value> _query;
+    std::vector<Event> _events;
+    std::vector<Hit> _hits;
+
+    void _sort() {
+        std::vector<Geometry::RadixItem> items;
+        items.reserve(_events.size());
+        for (Type type : {QUERY, CLOSE, OPEN}) {
+            for (size_type i = 0; i < _events.size(); ++i) {
+                if (_events[i].type == type)
+                    items.push_back(Geometry::RadixItem{Geometry::radix_key(_x(_events[i])), static_cast<uint32_t>(i)});
+            }
+        }
+        Geometry::radix_sort(items);
+
+        std::vector<Event> sorted;
+        sorted.reserve(_events.size());
+        for (const Geometry::RadixItem &item : items)
+            sorted.push_back(_events[item.index]);
+        _events.swap(sorted);
+    }
+
+    coordinate _x(const Event &e) const {
+        if (e.type == QUERY)
+            return _query[e.id].getX();
+        const Geometry::Edge<T> &edge = _zones[e.polygon]->polygon.getEdges()[e.id];
+        return (e.type == OPEN ? edge.minX() : edge.maxX()).getX();
+    }
+public:
+    MultiPolygonAlgorithm(const std::vector<Geometry::Points<value>> &polygons, const Geometry::Points<value> &queries) :
+            _query(queries) {
+        for (const Geometry::Points<value> &points : polygons)
+            _zones.emplace_back(new Zone(points));
+
+        for (size_type i = 0; i < _query.size(); ++i)
+            _events.push_back(Event{QUERY, 0, static_cast<uint32_t>(i)});
+        for (size_type k = 0; k < _zones.size(); ++k) {
+            for (const Geometry::Edge<T> &e : _zones[k]->polygon.getEdges()) {
+                if (e.getPosition() == Geometry::Position::VERTICAL)
+                    continue;
+                _events.push_back(Event{OPEN, static_cast<uint32_t>(k), static_cast<uint32_t>(e.getId())});
+                _events.push_back(Event{CLOSE, static_cast<uint32_t>(k), static_cast<uint32_t>(e.getId())});
+            }
+        }
+        _sort();
+    }
+
+    MultiPolygonAlgorithm(const MultiPolygonAlgorithm&) = delete;
+    MultiPolygonAlgorithm& operator=(const MultiPolygonAlgorithm&) = delete;
+
+    void run() {
+        // Zones enter the active set in min_x order and leave it lazily once
+        // the sweep has passed their max_x.
+        std::vector<uint32_t> order, active;
+        for (size_type k = 0; k < _zones.size(); ++k) {
+            if (!_zones[k]->polygon.getPoints().empty())
+                order.push_back(k);
+        }
+        std::sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b) {
+            return _zones[a]->min_x < _zones[b]->min_x;
+        });
+
+        size_type next = 0;
+        _hits.clear();
+        for (const Event &e : _events) {
+            if (e.type == OPEN) {
+                _zones[e.polygon]->open.insert(e.id);
+                continue;
+            }
+            if (e.type == CLOSE) {
+                _zones[e.polygon]->open.erase(e.id);
+                continue;
+            }
+
+            const value &q = _query[e.id];
+            while (next < order.size() && _zones[order[next]]->min_x <= q.getX())
+                active.push_back(order[next++]);
+
+            for (size_type i = 0; i < active.size();) {
+                const Zone &zone = *_zones[active[i]];
+                if (zone.max_x < q.getX()) {
+                    active[i] = active.back();
+                    active.pop_back();
+                    continue;
+                }
+
+                if (zone.min_y <= q.getY() && q.getY() <= zone.max_y) {
+                    Geometry::State state = zone.locate(q);
+                    if (state != Geometry::State::OUTSIDE)
+                        _hits.push_back(Hit{e.id, active[i], state});
+                }
+                ++i;
+            }
+        }
+
+        std::sort(_hits.begin(), _hits.end(), [](const Hit &a, const Hit &b) {
+            if (a.query == b.query) {
+                return a.polygon < b.polygon;
+            }
+            return a.query < b.query;
+        });
+    }
+
+    size_type polygons() const {
+        return _zones.size();
+    }
+
+    // Every (query, polygon) pair that is INSIDE or BORDER, ordered by query then polygon.
+    const std::vector<Hit>& hits() const {
+        return _hits;
+    }
+
+    // The dense form: one packed answer column per polygon.
+    std::vector<Geometry::Answers> matrix() const {
+        std::vector<Geometry::Answers> columns(_zones.size(), Geometry::Answers(_query.size()));
+        for (const Hit &hit : _hits)
+            columns[hit.polygon].set(hit.query, hit.state);
+        return columns;
+    }
+};
+
+
+#endif //GEOM_MULTI_POLYGON_H
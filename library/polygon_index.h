@@ -0,0 +1,297 @@
+#ifndef GEOM_POLYGON_INDEX_H
+#define GEOM_POLYGON_INDEX_H
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "geometry.h"
+
+namespace Geometry {
+    // Offline-built, read-only point location structure for one polygon.
+    //
+    // The sweep over the polygon edges is recorded in a persistent treap: for
+    // every distinct vertex x it keeps the status just before the events at x
+    // (what a query lying exactly on x sees) and just after them (what queries
+    // strictly between x and the next vertex see). A query is a binary search
+    // over the vertex xs followed by one root-to-leaf walk, i.e. O(log n), and
+    // the structure can be shared between threads once built.
+    template <class T>
+    class PolygonIndex {
+    private:
+        using value = T;
+        using reference = T&;
+        using const_reference = const T&;
+        using pointer = T*;
+        using size_type = size_t;
+        using coordinate = decltype(std::declval<const T&>().getX());
+
+        struct Node {
+            uint32_t edge;
+            uint32_t priority;
+            uint32_t left, right;
+        };
+
+        struct Vertical {
+            coordinate x, low, high;
+        };
+
+        static const uint32_t null = 0;
+
+        std::vector<Edge<value>> _edges;
+        std::vector<uint8_t> _inside_above;
+        std::vector<Node> _nodes;
+        std::vector<coordinate> _xs;
+        std::vector<uint32_t> _at, _after;
+        std::vector<Vertical> _verticals;
+        std::vector<value> _vertices;
+        uint32_t _version_start = 1;
+
+        static uint32_t _hash(uint32_t x) {
+            x ^= x >> 16;
+            x *= 0x7feb352dU;
+            x ^= x >> 15;
+            x *= 0x846ca68bU;
+            x ^= x >> 16;
+            return x;
+        }
+
+        bool _less(uint32_t a, uint32_t b) const {
+            EdgeLess<value> less;
+            if (less(_edges[a], _edges[b]))
+                return true;
+            if (less(_edges[b], _edges[a]))
+                return false;
+            return a < b;
+        }
+
+        uint32_t _make(uint32_t edge, uint32_t left, uint32_t right) {
+            _nodes.push_back(Node{edge, _hash(edge + 1), left, right});
+            return _nodes.size() - 1;
+        }
+
+        // Nodes created since the current version started are private to it and can be
+        // changed in place; older ones are shared with recorded roots and are copied.
+        uint32_t _own(uint32_t t) {
+            if (t >= _version_start)
+                return t;
+            _nodes.push_back(_nodes[t]);
+            return _nodes.size() - 1;
+        }
+
+        std::pair<uint32_t, uint32_t> _split(uint32_t t, uint32_t edge) {
+            if (t == null)
+                return {null, null};
+
+            t = _own(t);
+            if (_less(_nodes[t].edge, edge)) {
+                std::pair<uint32_t, uint32_t> parts = _split(_nodes[t].right, edge);
+                _nodes[t].right = parts.first;
+                return {t, parts.second};
+            }
+
+            std::pair<uint32_t, uint32_t> parts = _split(_nodes[t].left, edge);
+            _nodes[t].left = parts.second;
+            return {parts.first, t};
+        }
+
+        uint32_t _merge(uint32_t a, uint32_t b) {
+            if (a == null)
+                return b;
+            if (b == null)
+                return a;
+
+            if (_nodes[a].priority > _nodes[b].priority) {
+                a = _own(a);
+                uint32_t right = _merge(_nodes[a].right, b);
+                _nodes[a].right = right;
+                return a;
+            }
+
+            b = _own(b);
+            uint32_t left = _merge(a, _nodes[b].left);
+            _nodes[b].left = left;
+            return b;
+        }
+
+        uint32_t _insert(uint32_t t, uint32_t edge) {
+            if (t == null || _hash(edge + 1) > _nodes[t].priority) {
+                std::pair<uint32_t, uint32_t> parts = _split(t, edge);
+                return _make(edge, parts.first, parts.second);
+            }
+
+            t = _own(t);
+            if (_less(edge, _nodes[t].edge)) {
+                uint32_t left = _insert(_nodes[t].left, edge);
+                _nodes[t].left = left;
+            } else {
+                uint32_t right = _insert(_nodes[t].right, edge);
+                _nodes[t].right = right;
+            }
+            return t;
+        }
+
+        uint32_t _erase(uint32_t t, uint32_t edge) {
+            if (t == null)
+                return null;
+            if (_nodes[t].edge == edge)
+                return _merge(_nodes[t].left, _nodes[t].right);
+
+            t = _own(t);
+            if (_less(edge, _nodes[t].edge)) {
+                uint32_t left = _erase(_nodes[t].left, edge);
+                _nodes[t].left = left;
+            } else {
+                uint32_t right = _erase(_nodes[t].right, edge);
+                _nodes[t].right = right;
+            }
+            return t;
+        }
+
+        bool _on_vertical(const_reference p) const {
+            auto it = std::upper_bound(_verticals.begin(), _verticals.end(), p,
+                                       [](const_reference q, const Vertical &v) {
+                                           if (q.getX() == v.x) {
+                                               return q.getY() < v.low;
+                                           }
+                                           return q.getX() < v.x;
+                                       });
+            // _verticals keeps a running maximum of high within one x, so only the last
+            // interval starting at or below p has to be looked at.
+            return it != _verticals.begin() && (it - 1)->x == p.getX() && (it - 1)->high >= p.getY();
+        }
+
+        void _build() {
+            struct Event {
+                coordinate x;
+                bool open;
+                uint32_t edge;
+            };
+
+            std::vector<Event> events;
+            for (const Edge<value> &e : _edges) {
+                if (e.getPosition() == Position::VERTICAL) {
+                    _verticals.push_back(Vertical{e.first().getX(), e.minY().getY(), e.maxY().getY()});
+                    continue;
+                }
+                events.push_back(Event{e.minX().getX(), true, static_cast<uint32_t>(e.getId())});
+                events.push_back(Event{e.maxX().getX(), false, static_cast<uint32_t>(e.getId())});
+            }
+
+            std::sort(_verticals.begin(), _verticals.end(), [](const Vertical &a, const Vertical &b) {
+                if (a.x == b.x) {
+                    return a.low < b.low;
+                }
+                return a.x < b.x;
+            });
+            for (size_type i = 1; i < _verticals.size(); ++i) {
+                if (_verticals[i].x == _verticals[i - 1].x)
+                    _verticals[i].high = std::max(_verticals[i].high, _verticals[i - 1].high);
+            }
+
+            std::sort(events.begin(), events.end(), [](const Event &a, const Event &b) {
+                if (a.x == b.x) {
+                    return a.open < b.open;
+                }
+                return a.x < b.x;
+            });
+
+            _nodes.reserve(4 * events.size() + 1);
+            _nodes.push_back(Node{0, 0, null, null});
+
+            uint32_t root = null;
+            for (size_type i = 0; i < events.size();) {
+                coordinate x = events[i].x;
+                _xs.push_back(x);
+                _at.push_back(root);
+                _version_start = _nodes.size();
+
+                for (; i < events.size() && events[i].x == x; ++i) {
+                    if (events[i].open)
+                        root = _insert(root, events[i].edge);
+                    else
+                        root = _erase(root, events[i].edge);
+                }
+                _after.push_back(root);
+            }
+        }
+    public:
+        PolygonIndex() = default;
+
+        explicit PolygonIndex(const Points<value> &points) : _vertices(points.begin(), points.end()) {
+            AdvancedPolygon<value> polygon(points);
+            if (polygon.OrientArea() > 0) {
+                polygon.revertOrder();
+            }
+            polygon.setEdges();
+            _edges = polygon.getEdges();
+            for (const Edge<value> &e : _edges)
+                _inside_above.push_back(e.getPosition() == Position::UP);
+
+            std::sort(_vertices.begin(), _vertices.end(), LexicographicLess<value>());
+            _build();
+        }
+
+        // Builds over edges prepared by a sweep engine, e.g. of a polygon with
+        // holes: inside_above[i] tells whether the region just above edge i is
+        // inside. Edge ids must be their positions in edges.
+        PolygonIndex(const std::vector<Edge<value>> &edges, const std::vector<uint8_t> &inside_above,
+                     const Points<value> &points) :
+                _edges(edges), _inside_above(inside_above), _vertices(points.begin(), points.end()) {
+            std::sort(_vertices.begin(), _vertices.end(), LexicographicLess<value>());
+            _build();
+        }
+
+        State locate(const_reference p) const {
+            if (std::binary_search(_vertices.begin(), _vertices.end(), p, LexicographicLess<value>()))
+                return State::BORDER;
+            if (_on_vertical(p))
+                return State::BORDER;
+
+            auto it = std::lower_bound(_xs.begin(), _xs.end(), p.getX());
+            uint32_t t;
+            if (it != _xs.end() && *it == p.getX()) {
+                t = _at[it - _xs.begin()];
+            } else if (it != _xs.begin()) {
+                t = _after[it - _xs.begin() - 1];
+            } else {
+                return State::OUTSIDE;
+            }
+
+            const Edge<value> *below = nullptr;
+            while (t != null) {
+                const Edge<value> &e = _edges[_nodes[t].edge];
+                int side = e.side(p);
+                if (side == 0)
+                    return State::BORDER;
+
+                if (side > 0) {
+                    below = &e;
+                    t = _nodes[t].right;
+                } else {
+                    t = _nodes[t].left;
+                }
+            }
+
+            if (below != nullptr && _inside_above[below->getId()])
+                return State::INSIDE;
+            return State::OUTSIDE;
+        }
+
+        size_type size() const {
+            return _edges.size();
+        }
+
+        size_type nodes() const {
+            return _nodes.size();
+        }
+    };
+
+    // Bound by reference in _split's braced return, so it needs a definition.
+    template <class T>
+    const uint32_t PolygonIndex<T>::null;
+}
+
+
+#endif //GEOM_POLYGON_INDEX_H
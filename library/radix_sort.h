@@ -0,0 +1,127 @@
+#ifndef GEOM_RADIX_SORT_H
+#define GEOM_RADIX_SORT_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace Geometry {
+    struct RadixItem {
+        uint64_t key;
+        uint32_t index;
+    };
+
+    // Maps a coordinate to an unsigned key with the same order. Negative zero is
+    // folded into zero first, since the two compare equal.
+    inline uint64_t radix_key(double x) {
+        x += 0.0;
+        uint64_t bits;
+        std::memcpy(&bits, &x, sizeof(bits));
+        return (bits >> 63) ? ~bits : bits ^ (uint64_t(1) << 63);
+    }
+
+    template <class U>
+    typename std::enable_if<std::is_integral<U>::value, uint64_t>::type radix_key(U x) {
+        return static_cast<uint64_t>(static_cast<int64_t>(x)) ^ (uint64_t(1) << 63);
+    }
+
+    namespace Detail {
+        inline bool radix_pass_needed(const std::vector<RadixItem> &items, int shift) {
+            uint64_t first = (items[0].key >> shift) & 0xff;
+            for (const RadixItem &item : items) {
+                if (((item.key >> shift) & 0xff) != first)
+                    return true;
+            }
+            return false;
+        }
+    }
+
+    // Stable LSD radix sort by key, one byte per pass. Passes in which every key
+    // has the same byte are skipped, which is the common case for the high bytes
+    // of coordinates drawn from a narrow range.
+    inline void radix_sort(std::vector<RadixItem> &items) {
+        if (items.size() < 2)
+            return;
+
+        std::vector<RadixItem> buffer(items.size());
+        for (int shift = 0; shift < 64; shift += 8) {
+            if (!Detail::radix_pass_needed(items, shift))
+                continue;
+
+            size_t offset[256] = {};
+            for (const RadixItem &item : items)
+                offset[(item.key >> shift) & 0xff]++;
+
+            size_t sum = 0;
+            for (size_t &o : offset) {
+                size_t count = o;
+                o = sum;
+                sum += count;
+            }
+
+            for (const RadixItem &item : items)
+                buffer[offset[(item.key >> shift) & 0xff]++] = item;
+            items.swap(buffer);
+        }
+    }
+
+    // The same sort with every pass split over several threads: each counts the
+    // digits of its own chunk, the per-thread counts are turned into disjoint
+    // output ranges (thread order within a digit keeps the sort stable), and the
+    // chunks are scattered concurrently.
+    inline void parallel_radix_sort(std::vector<RadixItem> &items, size_t threads) {
+        if (threads <= 1 || items.size() < threads * 4096) {
+            radix_sort(items);
+            return;
+        }
+
+        std::vector<RadixItem> buffer(items.size());
+        std::vector<size_t> offset(threads * 256);
+        for (int shift = 0; shift < 64; shift += 8) {
+            if (!Detail::radix_pass_needed(items, shift))
+                continue;
+
+            auto chunk = [&items, threads](size_t t) {
+                return items.size() * t / threads;
+            };
+            auto run = [threads](std::function<void(size_t)> body) {
+                std::vector<std::thread> workers;
+                for (size_t t = 1; t < threads; ++t)
+                    workers.emplace_back(body, t);
+                body(0);
+                for (std::thread &w : workers)
+                    w.join();
+            };
+
+            std::fill(offset.begin(), offset.end(), 0);
+            run([&](size_t t) {
+                size_t *count = &offset[t * 256];
+                for (size_t i = chunk(t); i < chunk(t + 1); ++i)
+                    count[(items[i].key >> shift) & 0xff]++;
+            });
+
+            size_t sum = 0;
+            for (size_t digit = 0; digit < 256; ++digit) {
+                for (size_t t = 0; t < threads; ++t) {
+                    size_t count = offset[t * 256 + digit];
+                    offset[t * 256 + digit] = sum;
+                    sum += count;
+                }
+            }
+
+            run([&](size_t t) {
+                size_t *position = &offset[t * 256];
+                for (size_t i = chunk(t); i < chunk(t + 1); ++i)
+                    buffer[position[(items[i].key >> shift) & 0xff]++] = items[i];
+            });
+            items.swap(buffer);
+        }
+    }
+}
+
+
+#endif //GEOM_RADIX_SORT_H
@@ -0,0 +1,207 @@
+#ifndef GEOM_RAY_CASTING_H
+#define GEOM_RAY_CASTING_H
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "answers.h"
+#include "geometry.h"
+
+namespace Geometry {
+    // Brute-force crossing-number test of a batch of queries against every edge
+    // of a small polygon. Edges are stored as columns and oriented upwards, so a
+    // rightward ray from q crosses (a, b) iff a.y <= q.y < b.y and q lies strictly
+    // left of a->b; q is on the border iff the cross product is zero inside the
+    // edge's bounding box. Queries are processed four (AVX2) or two (SSE2) at a
+    // time, with a scalar loop for the tail and for other targets.
+    template <class T>
+    class RayCasting {
+    private:
+        using value = T;
+        using size_type = size_t;
+
+        std::vector<double> _ax, _ay, _bx, _by, _dx, _dy, _min_x, _max_x;
+
+        State _scalar(double x, double y) const {
+            bool inside = false;
+            for (size_type i = 0; i < _ax.size(); ++i) {
+                double cross = _dx[i] * (y - _ay[i]) - _dy[i] * (x - _ax[i]);
+                if (cross == 0 && _min_x[i] <= x && x <= _max_x[i] && _ay[i] <= y && y <= _by[i])
+                    return State::BORDER;
+                if (_ay[i] <= y && y < _by[i] && cross > 0)
+                    inside = !inside;
+            }
+            return inside ? State::INSIDE : State::OUTSIDE;
+        }
+
+        static State _state(int border, int inside, int lane) {
+            if ((border >> lane) & 1)
+                return State::BORDER;
+            return ((inside >> lane) & 1) ? State::INSIDE : State::OUTSIDE;
+        }
+
+#if defined(__AVX2__)
+        size_type _vector(const double *xs, const double *ys, size_type m, Answers &out, size_type offset) const {
+            size_type j = 0;
+            for (; j + 4 <= m; j += 4) {
+                __m256d x = _mm256_loadu_pd(xs + j), y = _mm256_loadu_pd(ys + j);
+                __m256d border = _mm256_setzero_pd(), inside = _mm256_setzero_pd();
+                const __m256d zero = _mm256_setzero_pd();
+
+                for (size_type i = 0; i < _ax.size(); ++i) {
+                    __m256d ax = _mm256_set1_pd(_ax[i]), ay = _mm256_set1_pd(_ay[i]), by = _mm256_set1_pd(_by[i]);
+                    __m256d cross = _mm256_sub_pd(_mm256_mul_pd(_mm256_set1_pd(_dx[i]), _mm256_sub_pd(y, ay)),
+                                                  _mm256_mul_pd(_mm256_set1_pd(_dy[i]), _mm256_sub_pd(x, ax)));
+
+                    __m256d low = _mm256_cmp_pd(ay, y, _CMP_LE_OQ);
+                    __m256d on = _mm256_and_pd(_mm256_cmp_pd(cross, zero, _CMP_EQ_OQ), low);
+                    on = _mm256_and_pd(on, _mm256_cmp_pd(y, by, _CMP_LE_OQ));
+                    on = _mm256_and_pd(on, _mm256_cmp_pd(_mm256_set1_pd(_min_x[i]), x, _CMP_LE_OQ));
+                    on = _mm256_and_pd(on, _mm256_cmp_pd(x, _mm256_set1_pd(_max_x[i]), _CMP_LE_OQ));
+                    border = _mm256_or_pd(border, on);
+
+                    __m256d crossing = _mm256_and_pd(low, _mm256_cmp_pd(y, by, _CMP_LT_OQ));
+                    crossing = _mm256_and_pd(crossing, _mm256_cmp_pd(cross, zero, _CMP_GT_OQ));
+                    inside = _mm256_xor_pd(inside, crossing);
+                }
+
+                int border_mask = _mm256_movemask_pd(border), inside_mask = _mm256_movemask_pd(inside);
+                for (int lane = 0; lane < 4; ++lane)
+                    out.set(offset + j + lane, _state(border_mask, inside_mask, lane));
+            }
+            return j;
+        }
+#elif defined(__SSE2__)
+        size_type _vector(const double *xs, const double *ys, size_type m, Answers &out, size_type offset) const {
+            size_type j = 0;
+            for (; j + 2 <= m; j += 2) {
+                __m128d x = _mm_loadu_pd(xs + j), y = _mm_loadu_pd(ys + j);
+                __m128d border = _mm_setzero_pd(), inside = _mm_setzero_pd();
+                const __m128d zero = _mm_setzero_pd();
+
+                for (size_type i = 0; i < _ax.size(); ++i) {
+                    __m128d ax = _mm_set1_pd(_ax[i]), ay = _mm_set1_pd(_ay[i]), by = _mm_set1_pd(_by[i]);
+                    __m128d cross = _mm_sub_pd(_mm_mul_pd(_mm_set1_pd(_dx[i]), _mm_sub_pd(y, ay)),
+                                               _mm_mul_pd(_mm_set1_pd(_dy[i]), _mm_sub_pd(x, ax)));
+
+                    __m128d low = _mm_cmple_pd(ay, y);
+                    __m128d on = _mm_and_pd(_mm_cmpeq_pd(cross, zero), low);
+                    on = _mm_and_pd(on, _mm_cmple_pd(y, by));
+                    on = _mm_and_pd(on, _mm_cmple_pd(_mm_set1_pd(_min_x[i]), x));
+                    on = _mm_and_pd(on, _mm_cmple_pd(x, _mm_set1_pd(_max_x[i])));
+                    border = _mm_or_pd(border, on);
+
+                    __m128d crossing = _mm_and_pd(low, _mm_cmplt_pd(y, by));
+                    crossing = _mm_and_pd(crossing, _mm_cmpgt_pd(cross, zero));
+                    inside = _mm_xor_pd(inside, crossing);
+                }
+
+                int border_mask = _mm_movemask_pd(border), inside_mask = _mm_movemask_pd(inside);
+                for (int lane = 0; lane < 2; ++lane)
+                    out.set(offset + j + lane, _state(border_mask, inside_mask, lane));
+            }
+            return j;
+        }
+#else
+        size_type _vector(const double *, const double *, size_type, Answers &, size_type) const {
+            return 0;
+        }
+#endif
+
+        // Answers queries offset..offset + m - 1 from coordinate columns.
+        void _run(const double *xs, const double *ys, size_type m, Answers &out, size_type offset) const {
+            for (size_type j = _vector(xs, ys, m, out, offset); j < m; ++j)
+                out.set(offset + j, _scalar(xs[j], ys[j]));
+        }
+
+        Answers _run_columns(const PointColumns<value> &queries, const double *xs, const double *ys) const {
+            Answers ans(queries.size());
+            _run(xs, ys, queries.size(), ans, 0);
+            return ans;
+        }
+
+        template <class C>
+        Answers _run_columns(const PointColumns<value> &queries, const C *, const C *) const {
+            return run<PointColumns<value>>(queries);
+        }
+    public:
+        explicit RayCasting(const Points<value> &polygon) {
+            size_type n = polygon.size();
+            for (size_type i = 0; i < n; ++i) {
+                value a = polygon[i], b = polygon[i + 1 == n ? 0 : i + 1];
+                if (b.getY() < a.getY())
+                    std::swap(a, b);
+
+                _ax.push_back(a.getX());
+                _ay.push_back(a.getY());
+                _bx.push_back(b.getX());
+                _by.push_back(b.getY());
+                _dx.push_back((double)b.getX() - a.getX());
+                _dy.push_back((double)b.getY() - a.getY());
+                _min_x.push_back(std::min<double>(a.getX(), b.getX()));
+                _max_x.push_back(std::max<double>(a.getX(), b.getX()));
+            }
+        }
+
+        // Answers m queries given as coordinate columns; out must hold m answers.
+        void run(const double *xs, const double *ys, size_type m, Answers &out) const {
+            _run(xs, ys, m, out, 0);
+        }
+
+        // Queries are converted to doubles a block at a time, so no copy of
+        // the whole batch is made.
+        template <class Queries>
+        Answers run(const Queries &queries) const {
+            static const size_type block = 256;
+            double xs[block], ys[block];
+            Answers ans(queries.size());
+            size_type offset = 0, m = 0;
+            for (value q : queries) {
+                xs[m] = q.getX();
+                ys[m] = q.getY();
+                if (++m == block) {
+                    _run(xs, ys, m, ans, offset);
+                    offset += m;
+                    m = 0;
+                }
+            }
+            _run(xs, ys, m, ans, offset);
+            return ans;
+        }
+
+        // Columns of doubles go to the kernel as they are; other coordinate types
+        // are converted by the generic overload.
+        Answers run(const PointColumns<value> &queries) const {
+            return _run_columns(queries, queries.x(), queries.y());
+        }
+
+        State locate(const value &p) const {
+            return _scalar(p.getX(), p.getY());
+        }
+
+        // True when n * m is small enough that testing every pair beats building and
+        // sweeping n + m events. The factor is where 'geom_bench raycast' measured the
+        // crossover: about 64 with the AVX2 kernel and 20 with SSE2.
+        static bool preferable(size_type n, size_type m) {
+#if defined(__AVX2__)
+            static const double factor = 64.0;
+#else
+            static const double factor = 20.0;
+#endif
+            size_type total = n + m, log = 1;
+            while ((size_type(1) << log) < total)
+                log++;
+            return (double)n * m <= factor * total * log;
+        }
+    };
+}
+
+
+#endif //GEOM_RAY_CASTING_H
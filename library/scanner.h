@@ -0,0 +1,252 @@
+#ifndef GEOM_SCANNER_H
+#define GEOM_SCANNER_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "geometry.h"
+
+namespace IO {
+    class MappedFile {
+    private:
+        using size_type = size_t;
+
+        const char *_data = nullptr;
+        size_type _size = 0;
+        bool _mapped = false;
+    public:
+        // Maps a regular file read-only; pipes and terminals are left unmapped.
+        explicit MappedFile(int fd) {
+            struct stat st;
+            if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size <= 0)
+                return;
+
+            void *data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data == MAP_FAILED)
+                return;
+
+            madvise(data, st.st_size, MADV_SEQUENTIAL);
+            _data = static_cast<const char*>(data);
+            _size = st.st_size;
+            _mapped = true;
+        }
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        ~MappedFile() {
+            if (_mapped)
+                munmap(const_cast<char*>(_data), _size);
+        }
+
+        bool isMapped() const {
+            return _mapped;
+        }
+
+        const char* begin() const {
+            return _data;
+        }
+
+        const char* end() const {
+            return _data + _size;
+        }
+
+        size_type size() const {
+            return _size;
+        }
+    };
+
+    // A whole input as one contiguous buffer: mapped when it is a regular file,
+    // read into memory otherwise (pipes, terminals).
+    class InputBuffer {
+    private:
+        using size_type = size_t;
+
+        MappedFile _file;
+        std::vector<char> _data;
+    public:
+        explicit InputBuffer(int fd) : _file(fd) {
+            if (_file.isMapped())
+                return;
+
+            char chunk[1 << 16];
+            ssize_t got;
+            while ((got = ::read(fd, chunk, sizeof(chunk))) > 0)
+                _data.insert(_data.end(), chunk, chunk + got);
+        }
+
+        const char* begin() const {
+            return _file.isMapped() ? _file.begin() : _data.data();
+        }
+
+        const char* end() const {
+            return _file.isMapped() ? _file.end() : _data.data() + _data.size();
+        }
+    };
+
+    class Scanner {
+    private:
+        using size_type = size_t;
+
+        const char *_cur, *_end;
+        bool _fail = false;
+
+        static bool _is_space(char c) {
+            return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\v' || c == '\f';
+        }
+
+        static bool _is_digit(char c) {
+            return static_cast<unsigned char>(c - '0') < 10;
+        }
+
+        void _skip() {
+            while (_cur != _end && _is_space(*_cur))
+                ++_cur;
+            if (_cur == _end)
+                _fail = true;
+        }
+
+        template <class U>
+        void _parse_integer(U &value) {
+            _skip();
+            if (_fail)
+                return;
+
+            bool negative = false;
+            if (*_cur == '-' || *_cur == '+')
+                negative = (*_cur++ == '-');
+
+            if (_cur == _end || !_is_digit(*_cur)) {
+                _fail = true;
+                return;
+            }
+
+            typename std::make_unsigned<U>::type result = 0;
+            while (_cur != _end && _is_digit(*_cur))
+                result = result * 10 + (*_cur++ - '0');
+
+            value = static_cast<U>(negative ? 0 - result : result);
+        }
+
+        // Clinger's fast path: a mantissa below 2^53 and a power of ten up to 1e22
+        // are both exact, so one IEEE multiplication or division rounds correctly.
+        // Everything else is handed to strtod, so results always match operator>>.
+        template <class U>
+        void _parse_floating(U &value) {
+            static const double pow10[] = {
+                    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+            };
+
+            _skip();
+            if (_fail)
+                return;
+
+            const char *start = _cur;
+            bool negative = false;
+            if (*_cur == '-' || *_cur == '+')
+                negative = (*_cur++ == '-');
+
+            uint64_t mantissa = 0;
+            int digits = 0, exponent = 0;
+            bool any = false;
+            while (_cur != _end && _is_digit(*_cur)) {
+                if (digits < 19) {
+                    mantissa = mantissa * 10 + (*_cur - '0');
+                    digits += (mantissa != 0);
+                } else {
+                    exponent++;
+                }
+                any = true;
+                ++_cur;
+            }
+
+            if (_cur != _end && *_cur == '.') {
+                ++_cur;
+                while (_cur != _end && _is_digit(*_cur)) {
+                    if (digits < 19) {
+                        mantissa = mantissa * 10 + (*_cur - '0');
+                        digits += (mantissa != 0);
+                        exponent--;
+                    }
+                    any = true;
+                    ++_cur;
+                }
+            }
+
+            if (!any) {
+                _fail = true;
+                return;
+            }
+
+            if (_cur != _end && (*_cur == 'e' || *_cur == 'E')) {
+                const char *mark = _cur++;
+                bool exp_negative = false;
+                if (_cur != _end && (*_cur == '-' || *_cur == '+'))
+                    exp_negative = (*_cur++ == '-');
+
+                if (_cur == _end || !_is_digit(*_cur)) {
+                    _cur = mark;
+                } else {
+                    int e = 0;
+                    while (_cur != _end && _is_digit(*_cur)) {
+                        if (e < 100000)
+                            e = e * 10 + (*_cur - '0');
+                        ++_cur;
+                    }
+                    exponent += (exp_negative ? -e : e);
+                }
+            }
+
+            if (mantissa < (uint64_t(1) << 53) && exponent >= -22 && exponent <= 22) {
+                double result = static_cast<double>(mantissa);
+                result = (exponent < 0 ? result / pow10[-exponent] : result * pow10[exponent]);
+                value = static_cast<U>(negative ? -result : result);
+                return;
+            }
+
+            // Copied whole: cutting a long mantissa short would change the value.
+            std::string token(start, _cur);
+            value = static_cast<U>(std::strtod(token.c_str(), nullptr));
+        }
+    public:
+        Scanner(const char *begin, const char *end) : _cur(begin), _end(end) {}
+
+        explicit operator bool() const {
+            return !_fail;
+        }
+
+        template <class U>
+        typename std::enable_if<std::is_integral<U>::value, Scanner&>::type operator>>(U &value) {
+            _parse_integer(value);
+            return *this;
+        }
+
+        template <class U>
+        typename std::enable_if<std::is_floating_point<U>::value, Scanner&>::type operator>>(U &value) {
+            _parse_floating(value);
+            return *this;
+        }
+
+        template <class U>
+        Scanner& operator>>(Geometry::Point<U> &p) {
+            U x = U(), y = U();
+            *this >> x >> y;
+            p = Geometry::Point<U>(x, y, 0);
+            return *this;
+        }
+    };
+}
+
+
+#endif //GEOM_SCANNER_H
@@ -0,0 +1,167 @@
+#ifndef GEOM_STATS_H
+#define GEOM_STATS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+
+// Per-test instrumentation. Building with GEOM_STATS defined turns the macros at
+// the bottom into timers and counters that feed the Stats::Record installed for
+// the current thread; without it they expand to nothing and cost nothing.
+namespace Stats {
+    enum Phase {
+        PARSE,
+        BUILD,
+        ORDER,
+        EDGES,
+        EVENTS,
+        SORT,
+        VERTICALS,
+        SWEEP,
+        QUERY,
+        OUTPUT,
+        PHASES,
+    };
+
+    enum Counter {
+        EVENT,
+        INSERT,
+        ERASE,
+        COMPARISON,
+        PROBE,
+        VERTEX_HIT,
+        PREFILTERED,
+        COUNTERS,
+    };
+
+    inline const char* name(Phase phase) {
+        static const char *names[] = {
+                "parse", "build", "order", "edges", "events", "sort", "verticals", "sweep", "query", "output"
+        };
+        return names[phase];
+    }
+
+    inline const char* name(Counter counter) {
+        static const char *names[] = {
+                "events", "inserts", "erases", "comparisons", "probes", "vertex_hits", "prefiltered"
+        };
+        return names[counter];
+    }
+
+    // Counters are atomic because the slabs of one test are swept by several threads.
+    class Record {
+    private:
+        double _seconds[PHASES];
+        std::atomic<uint64_t> _counters[COUNTERS];
+    public:
+        Record() {
+            reset();
+        }
+
+        Record(const Record &other) {
+            *this = other;
+        }
+
+        Record& operator=(const Record &other) {
+            for (int i = 0; i < PHASES; ++i)
+                _seconds[i] = other._seconds[i];
+            for (int i = 0; i < COUNTERS; ++i)
+                _counters[i].store(other._counters[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+            return *this;
+        }
+
+        void reset() {
+            for (int i = 0; i < PHASES; ++i)
+                _seconds[i] = 0;
+            for (int i = 0; i < COUNTERS; ++i)
+                _counters[i].store(0, std::memory_order_relaxed);
+        }
+
+        void add(Phase phase, double seconds) {
+            _seconds[phase] += seconds;
+        }
+
+        void add(Counter counter, uint64_t amount) {
+            _counters[counter].fetch_add(amount, std::memory_order_relaxed);
+        }
+
+        double seconds(Phase phase) const {
+            return _seconds[phase];
+        }
+
+        uint64_t count(Counter counter) const {
+            return _counters[counter].load(std::memory_order_relaxed);
+        }
+
+        // Writes the body of a JSON object: "seconds": {...}, "counters": {...}.
+        void write(std::ostream &os) const {
+            os << "\"seconds\":{";
+            for (int i = 0; i < PHASES; ++i)
+                os << (i ? "," : "") << '"' << name(static_cast<Phase>(i)) << "\":" << _seconds[i];
+            os << "},\"counters\":{";
+            for (int i = 0; i < COUNTERS; ++i)
+                os << (i ? "," : "") << '"' << name(static_cast<Counter>(i)) << "\":" << count(static_cast<Counter>(i));
+            os << '}';
+        }
+    };
+
+    inline Record*& current() {
+        static thread_local Record *record = nullptr;
+        return record;
+    }
+
+    // Installs a record for the current thread for the lifetime of the scope.
+    class Scope {
+    private:
+        Record *_previous;
+    public:
+        explicit Scope(Record *record) : _previous(current()) {
+            current() = record;
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+        ~Scope() {
+            current() = _previous;
+        }
+    };
+
+    class Timer {
+    private:
+        Phase _phase;
+        std::chrono::steady_clock::time_point _start;
+    public:
+        explicit Timer(Phase phase) : _phase(phase), _start(std::chrono::steady_clock::now()) {}
+
+        Timer(const Timer&) = delete;
+        Timer& operator=(const Timer&) = delete;
+
+        ~Timer() {
+            if (current() != nullptr)
+                current()->add(_phase, std::chrono::duration<double>(std::chrono::steady_clock::now() - _start).count());
+        }
+    };
+
+    inline void count(Counter counter, uint64_t amount = 1) {
+        if (current() != nullptr)
+            current()->add(counter, amount);
+    }
+}
+
+#define GEOM_STATS_CONCAT_(a, b) a##b
+#define GEOM_STATS_CONCAT(a, b) GEOM_STATS_CONCAT_(a, b)
+
+#ifdef GEOM_STATS
+#define GEOM_STATS_SCOPE(record) Stats::Scope GEOM_STATS_CONCAT(stats_scope_, __LINE__)(record)
+#define GEOM_STATS_TIMER(phase) Stats::Timer GEOM_STATS_CONCAT(stats_timer_, __LINE__)(Stats::phase)
+#define GEOM_STATS_COUNT(counter, amount) Stats::count(Stats::counter, amount)
+#else
+#define GEOM_STATS_SCOPE(record) do {} while (false)
+#define GEOM_STATS_TIMER(phase) do {} while (false)
+#define GEOM_STATS_COUNT(counter, amount) do {} while (false)
+#endif
+
+
+#endif //GEOM_STATS_H
@@ -0,0 +1,254 @@
+#ifndef GEOM_SWEEP_STATUS_H
+#define GEOM_SWEEP_STATUS_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include <sys/types.h>
+
+#include "arena.h"
+#include "geometry.h"
+
+namespace Geometry {
+    // Sweep status structures: the set of edges crossed by the sweep line, ordered
+    // bottom to top. Both take edge ids (indices into the polygon's edge list) and
+    // answer locate(p) with the ids of the edges directly below p and the first
+    // edge at or above p, -1 standing for "none".
+
+    template <class T>
+    class MultisetStatus {
+    private:
+        using value = T;
+        using size_type = size_t;
+
+        const std::vector<Edge<value>> &_edges;
+        std::multiset<Edge<value>, EdgeLess<value>, Memory::ArenaAllocator<Edge<value>>> _open;
+    public:
+        // Nodes come from arena when one is given; it must outlive the status or
+        // at least its last clear().
+        explicit MultisetStatus(const std::vector<Edge<value>> &edges, Memory::Arena *arena = nullptr) :
+                _edges(edges), _open(EdgeLess<value>(), arena) {}
+
+        void insert(size_type edge) {
+            _open.insert(_edges[edge]);
+        }
+
+        void erase(size_type edge) {
+            _open.erase(_open.find(_edges[edge]));
+        }
+
+        void clear() {
+            _open.clear();
+        }
+
+        bool empty() const {
+            return _open.empty();
+        }
+
+        size_type size() const {
+            return _open.size();
+        }
+
+        std::pair<ssize_t, ssize_t> locate(const value &p) const {
+            Edge<value> query(p, p);
+
+            auto it = _open.lower_bound(query);
+            ssize_t above = (it != _open.end() ? it->getId() : -1);
+            ssize_t below = (it != _open.begin() ? std::prev(it)->getId() : -1);
+            return {below, above};
+        }
+    };
+
+    // Edge ids kept in sorted fixed-size blocks drawn from a pool, with a separate
+    // array holding the block order. Lookups are two binary searches over
+    // contiguous memory and updates shift at most one block; emptied blocks go
+    // back to a free list, so a long sweep allocates only while the status grows.
+    template <class T>
+    class BlockStatus {
+    private:
+        using value = T;
+        using size_type = size_t;
+
+        static const size_type capacity = 64;
+
+        struct Block {
+            uint32_t size;
+            uint32_t items[capacity];
+        };
+
+        const std::vector<Edge<value>> &_edges;
+        std::vector<Block> _pool;
+        std::vector<uint32_t> _free;
+        std::vector<uint32_t> _order;
+        size_type _size = 0;
+
+        bool _less(uint32_t a, uint32_t b) const {
+            return EdgeLess<value>()(_edges[a], _edges[b]);
+        }
+
+        bool _below(uint32_t edge, const value &p) const {
+            return _edges[edge].side(p) > 0;
+        }
+
+        Block& _block(size_type position) {
+            return _pool[_order[position]];
+        }
+
+        const Block& _block(size_type position) const {
+            return _pool[_order[position]];
+        }
+
+        uint32_t _allocate() {
+            if (!_free.empty()) {
+                uint32_t id = _free.back();
+                _free.pop_back();
+                return id;
+            }
+            _pool.emplace_back();
+            return _pool.size() - 1;
+        }
+
+        void _release(size_type position) {
+            _free.push_back(_order[position]);
+            _order.erase(_order.begin() + position);
+        }
+
+        void _split(size_type position) {
+            uint32_t id = _allocate();
+            Block &left = _block(position), &right = _pool[id];
+
+            right.size = left.size / 2;
+            left.size -= right.size;
+            std::memcpy(right.items, left.items + left.size, right.size * sizeof(uint32_t));
+            _order.insert(_order.begin() + position + 1, id);
+        }
+
+        void _merge_next(size_type position) {
+            if (position + 1 >= _order.size())
+                return;
+
+            Block &left = _block(position), &right = _block(position + 1);
+            if (left.size >= capacity / 4 || left.size + right.size > capacity / 2)
+                return;
+
+            std::memcpy(left.items + left.size, right.items, right.size * sizeof(uint32_t));
+            left.size += right.size;
+            _release(position + 1);
+        }
+    public:
+        // Not arena-backed: the arena argument exists so both statuses construct
+        // alike. Blocks live in a vector pool that clear() keeps; a bump arena
+        // could not take back the buffers a growing vector leaves behind.
+        explicit BlockStatus(const std::vector<Edge<value>> &edges, Memory::Arena * = nullptr) : _edges(edges) {}
+
+        void insert(size_type edge) {
+            uint32_t id = edge;
+            if (_order.empty()) {
+                uint32_t block = _allocate();
+                _pool[block].size = 1;
+                _pool[block].items[0] = id;
+                _order.push_back(block);
+                _size++;
+                return;
+            }
+
+            // Like std::multiset::insert, equivalent edges go after the ones already there.
+            size_type position = std::partition_point(_order.begin(), _order.end(), [this, id](uint32_t b) {
+                return !_less(id, _pool[b].items[_pool[b].size - 1]);
+            }) - _order.begin();
+            if (position == _order.size())
+                position--;
+
+            if (_block(position).size == capacity) {
+                _split(position);
+                Block &left = _block(position);
+                if (!_less(id, left.items[left.size - 1]))
+                    position++;
+            }
+
+            Block &block = _block(position);
+            uint32_t *at = std::upper_bound(block.items, block.items + block.size, id, [this](uint32_t a, uint32_t b) {
+                return _less(a, b);
+            });
+            std::memmove(at + 1, at, (block.items + block.size - at) * sizeof(uint32_t));
+            *at = id;
+            block.size++;
+            _size++;
+        }
+
+        void erase(size_type edge) {
+            uint32_t id = edge;
+            size_type position = std::partition_point(_order.begin(), _order.end(), [this, id](uint32_t b) {
+                return _less(_pool[b].items[_pool[b].size - 1], id);
+            }) - _order.begin();
+
+            // Walk the run of equivalent edges until the exact id turns up.
+            for (; position < _order.size(); ++position) {
+                Block &block = _block(position);
+                uint32_t *begin = std::lower_bound(block.items, block.items + block.size, id, [this](uint32_t a, uint32_t b) {
+                    return _less(a, b);
+                });
+                uint32_t *at = std::find(begin, block.items + block.size, id);
+                if (at == block.items + block.size)
+                    continue;
+
+                std::memmove(at, at + 1, (block.items + block.size - at - 1) * sizeof(uint32_t));
+                block.size--;
+                _size--;
+                if (block.size == 0)
+                    _release(position);
+                else
+                    _merge_next(position);
+                return;
+            }
+        }
+
+        // Hands every block back to the free list; the pool itself is kept.
+        void clear() {
+            _order.clear();
+            _free.clear();
+            for (size_type i = _pool.size(); i > 0; --i)
+                _free.push_back(i - 1);
+            _size = 0;
+        }
+
+        bool empty() const {
+            return _size == 0;
+        }
+
+        size_type size() const {
+            return _size;
+        }
+
+        std::pair<ssize_t, ssize_t> locate(const value &p) const {
+            size_type position = std::partition_point(_order.begin(), _order.end(), [this, &p](uint32_t b) {
+                return _below(_pool[b].items[_pool[b].size - 1], p);
+            }) - _order.begin();
+
+            ssize_t below = -1, above = -1;
+            if (position == _order.size()) {
+                if (position != 0)
+                    below = _block(position - 1).items[_block(position - 1).size - 1];
+                return {below, above};
+            }
+
+            const Block &block = _block(position);
+            const uint32_t *at = std::partition_point(block.items, block.items + block.size, [this, &p](uint32_t e) {
+                return _below(e, p);
+            });
+            above = *at;
+            if (at != block.items)
+                below = *(at - 1);
+            else if (position != 0)
+                below = _block(position - 1).items[_block(position - 1).size - 1];
+            return {below, above};
+        }
+    };
+}
+
+
+#endif //GEOM_SWEEP_STATUS_H
@@ -0,0 +1,246 @@
+#ifndef GEOM_TRAPEZOID_MAP_H
+#define GEOM_TRAPEZOID_MAP_H
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "geometry.h"
+
+namespace Geometry {
+    // Read-only point location by a randomized incremental trapezoidal map.
+    //
+    // The edges are inserted in random order; every insertion replaces the
+    // leaves of the trapezoids it crosses with small subtrees, so the search
+    // structure is a DAG of expected O(n) nodes and expected O(log n) depth.
+    // Nodes live in one flat array and refer to each other by index. The
+    // order comes from the seed, by default a fresh random one, since a fixed
+    // order would make the expectation hold over inputs rather than over
+    // builds; pass a seed to reproduce a build.
+    //
+    // Points are compared lexicographically (x, then y), which is the map of
+    // the plane sheared by an infinitesimal amount: no two vertices share an
+    // x, and a vertical edge is an ordinary, very steep one. A query equal to
+    // a vertex stops at that vertex's x-node, a query on an edge (vertical or
+    // not) at that edge's y-node; both are BORDER. Any other query ends in a
+    // trapezoid, which is inside exactly when the region above its bottom
+    // edge is.
+    template <class T>
+    class TrapezoidMap {
+    private:
+        using value = T;
+        using reference = T&;
+        using const_reference = const T&;
+        using pointer = T*;
+        using size_type = size_t;
+
+        enum Type : uint8_t {
+            X,
+            Y,
+            LEAF,
+        };
+
+        // X: id is a vertex, left/right the lexicographically smaller/greater side.
+        // Y: id is a segment, left/right the side below/above it.
+        // LEAF: id is a trapezoid while building and the answer afterwards.
+        struct Node {
+            Type type;
+            uint32_t id;
+            uint32_t left, right;
+        };
+
+        // Endpoints are vertex ids, left < right.
+        struct Segment {
+            uint32_t left, right;
+        };
+
+        // none stands for the unbounded side.
+        struct Trapezoid {
+            uint32_t top, bottom;
+            uint32_t left, right;
+            uint32_t node;
+        };
+
+        static const uint32_t none = UINT32_MAX;
+
+        // Sorted lexicographically, so vertex ids compare like the vertices.
+        std::vector<value> _vertices;
+        std::vector<Segment> _segments;
+        std::vector<uint8_t> _inside_above;
+        std::vector<Node> _nodes;
+        std::vector<Trapezoid> _trapezoids;
+
+        uint32_t _vertex(const_reference p) const {
+            return std::lower_bound(_vertices.begin(), _vertices.end(), p, LexicographicLess<value>()) -
+                   _vertices.begin();
+        }
+
+        int _turn(uint32_t s, const_reference p) const {
+            return turn(_vertices[_segments[s].left], _vertices[_segments[s].right], p);
+        }
+
+        // Whether segment s runs above segment t where both are defined. They
+        // do not cross, so when s has an endpoint on each side of t's line, t
+        // lies wholly on one side of s instead.
+        bool _above(uint32_t s, uint32_t t) const {
+            int a = _turn(t, _vertices[_segments[s].left]), b = _turn(t, _vertices[_segments[s].right]);
+            if (a == 0 || b == 0 || a == b)
+                return a + b > 0;
+            int c = _turn(s, _vertices[_segments[t].left]), d = _turn(s, _vertices[_segments[t].right]);
+            return (c != 0 ? c : d) < 0;
+        }
+
+        uint32_t _node(const Node &node) {
+            _nodes.push_back(node);
+            return _nodes.size() - 1;
+        }
+
+        uint32_t _trapezoid(uint32_t top, uint32_t bottom, uint32_t left) {
+            _trapezoids.push_back(Trapezoid{top, bottom, left, none, none});
+            _trapezoids.back().node = _node(Node{LEAF, static_cast<uint32_t>(_trapezoids.size() - 1), none, none});
+            return _trapezoids.size() - 1;
+        }
+
+        // The trapezoid that segment s enters just right of its vertex v.
+        uint32_t _find(uint32_t s, uint32_t v) const {
+            uint32_t k = 0;
+            while (_nodes[k].type != LEAF) {
+                const Node &node = _nodes[k];
+                if (node.type == X)
+                    k = (v < node.id ? node.left : node.right);
+                else
+                    k = (_above(s, node.id) ? node.right : node.left);
+            }
+            return _nodes[k].id;
+        }
+
+        void _insert(uint32_t s) {
+            uint32_t p = _segments[s].left, r = _segments[s].right;
+
+            std::vector<uint32_t> crossed(1, _find(s, p));
+            while (_trapezoids[crossed.back()].right != none && _trapezoids[crossed.back()].right < r)
+                crossed.push_back(_find(s, _trapezoids[crossed.back()].right));
+
+            // Trapezoid fields are copied out: new trapezoids may reallocate the array.
+            Trapezoid first = _trapezoids[crossed.front()], last = _trapezoids[crossed.back()];
+            uint32_t before = none, after = none;
+            if (first.left != p) {
+                before = _trapezoid(first.top, first.bottom, first.left);
+                _trapezoids[before].right = p;
+            }
+            if (last.right != r) {
+                after = _trapezoid(last.top, last.bottom, r);
+                _trapezoids[after].right = last.right;
+            }
+
+            // The parts above and below s merge across every wall whose vertex
+            // is on the other side of s.
+            uint32_t upper = _trapezoid(first.top, s, p), lower = _trapezoid(s, first.bottom, p);
+            for (size_type j = 0; j < crossed.size(); ++j) {
+                Trapezoid old = _trapezoids[crossed[j]];
+                Node root{Y, s, _trapezoids[lower].node, _trapezoids[upper].node};
+                if (j + 1 == crossed.size() && after != none)
+                    root = Node{X, r, _node(root), _trapezoids[after].node};
+                if (j == 0 && before != none)
+                    root = Node{X, p, _trapezoids[before].node, _node(root)};
+                _nodes[old.node] = root;
+
+                if (j + 1 == crossed.size())
+                    break;
+                uint32_t v = old.right;
+                uint32_t next = crossed[j + 1];
+                if (turn(_vertices[p], _vertices[r], _vertices[v]) > 0) {
+                    _trapezoids[upper].right = v;
+                    upper = _trapezoid(_trapezoids[next].top, s, v);
+                } else {
+                    _trapezoids[lower].right = v;
+                    lower = _trapezoid(s, _trapezoids[next].bottom, v);
+                }
+            }
+            _trapezoids[upper].right = r;
+            _trapezoids[lower].right = r;
+        }
+
+        void _build(uint32_t seed) {
+            std::vector<uint32_t> order(_segments.size());
+            for (size_type i = 0; i < order.size(); ++i)
+                order[i] = i;
+            std::shuffle(order.begin(), order.end(), std::mt19937(seed));
+
+            _nodes.reserve(8 * _segments.size() + 1);
+            _trapezoid(none, none, none);
+            for (uint32_t s : order)
+                _insert(s);
+
+            // Only the answers are needed from here on.
+            for (Node &node : _nodes) {
+                if (node.type != LEAF)
+                    continue;
+                uint32_t bottom = _trapezoids[node.id].bottom;
+                bool inside = (bottom != none && _inside_above[bottom]);
+                node.id = static_cast<uint32_t>(inside ? State::INSIDE : State::OUTSIDE);
+            }
+            std::vector<Trapezoid>().swap(_trapezoids);
+        }
+    public:
+        TrapezoidMap() = default;
+
+        explicit TrapezoidMap(const Points<value> &points, uint32_t seed = std::random_device()()) :
+                _vertices(points.begin(), points.end()) {
+            std::sort(_vertices.begin(), _vertices.end(), LexicographicLess<value>());
+            _vertices.erase(std::unique(_vertices.begin(), _vertices.end()), _vertices.end());
+
+            AdvancedPolygon<value> polygon(points);
+            if (polygon.OrientArea() > 0) {
+                polygon.revertOrder();
+            }
+            polygon.setEdges();
+            // Clockwise, so the inside is right of every edge: above it when
+            // the edge runs from the greater vertex to the smaller one.
+            for (const Edge<value> &e : polygon.getEdges()) {
+                uint32_t a = _vertex(e.first()), b = _vertex(e.second());
+                if (a == b)
+                    continue;
+                _segments.push_back(Segment{std::min(a, b), std::max(a, b)});
+                _inside_above.push_back(a > b);
+            }
+            _build(seed);
+        }
+
+        State locate(const_reference p) const {
+            LexicographicLess<value> less;
+            uint32_t k = 0;
+            while (_nodes[k].type != LEAF) {
+                const Node &node = _nodes[k];
+                if (node.type == X) {
+                    const_reference v = _vertices[node.id];
+                    if (less(p, v)) {
+                        k = node.left;
+                    } else if (less(v, p)) {
+                        k = node.right;
+                    } else {
+                        return State::BORDER;
+                    }
+                } else {
+                    int side = _turn(node.id, p);
+                    if (side == 0)
+                        return State::BORDER;
+                    k = (side > 0 ? node.right : node.left);
+                }
+            }
+            return static_cast<State>(_nodes[k].id);
+        }
+
+        size_type size() const {
+            return _segments.size();
+        }
+
+        size_type nodes() const {
+            return _nodes.size();
+        }
+    };
+}
+
+
+#endif //GEOM_TRAPEZOID_MAP_H
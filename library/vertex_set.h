@@ -0,0 +1,144 @@
+#ifndef GEOM_VERTEX_SET_H
+#define GEOM_VERTEX_SET_H
+
+#include <cstdint>
+#include <vector>
+
+#include "radix_sort.h"
+
+namespace Geometry {
+    // Open-addressing hash set of polygon vertices, keyed on the exact
+    // coordinates. Coordinates go through radix_key first, which is a bijection
+    // on everything except -0.0 (folded into 0.0), so two points are found
+    // equal exactly when they compare equal. Linear probing over a flat slot
+    // array keeps a lookup to one or two cache lines. Each slot counts the
+    // copies of its point, so a repeated vertex survives erasing one of them.
+    template <class T>
+    class VertexSet {
+    private:
+        using value = T;
+        using size_type = size_t;
+
+        // count == 0 marks a free slot.
+        struct Slot {
+            uint64_t x, y;
+            uint32_t count;
+        };
+
+        std::vector<Slot> _slots;
+        size_type _size = 0;
+
+        static uint64_t _hash(uint64_t x, uint64_t y) {
+            uint64_t h = x * 0x9e3779b97f4a7c15ULL ^ y;
+            h ^= h >> 31;
+            h *= 0xbf58476d1ce4e5b9ULL;
+            h ^= h >> 29;
+            return h;
+        }
+
+        void _place(uint64_t x, uint64_t y, uint32_t count) {
+            size_type mask = _slots.size() - 1;
+            for (size_type i = _hash(x, y) & mask;; i = (i + 1) & mask) {
+                Slot &slot = _slots[i];
+                if (slot.count == 0) {
+                    slot = Slot{x, y, count};
+                    _size++;
+                    return;
+                }
+                if (slot.x == x && slot.y == y) {
+                    slot.count += count;
+                    return;
+                }
+            }
+        }
+
+        // The slot holding (x, y), or the free slot ending its probe run.
+        size_type _find(uint64_t x, uint64_t y) const {
+            size_type mask = _slots.size() - 1;
+            size_type i = _hash(x, y) & mask;
+            while (_slots[i].count != 0 && !(_slots[i].x == x && _slots[i].y == y))
+                i = (i + 1) & mask;
+            return i;
+        }
+
+        void _grow(size_type capacity) {
+            std::vector<Slot> old;
+            old.swap(_slots);
+            _slots.assign(capacity, Slot{0, 0, 0});
+            _size = 0;
+            for (const Slot &slot : old) {
+                if (slot.count != 0)
+                    _place(slot.x, slot.y, slot.count);
+            }
+        }
+    public:
+        // Sizes the table for n vertices at a load factor of at most one half.
+        void reserve(size_type n) {
+            size_type capacity = 16;
+            while (capacity < 2 * n)
+                capacity *= 2;
+            if (capacity > _slots.size())
+                _grow(capacity);
+        }
+
+        void insert(const value &p) {
+            if (2 * (_size + 1) > _slots.size())
+                _grow(_slots.empty() ? 16 : 2 * _slots.size());
+            _place(radix_key(p.getX()), radix_key(p.getY()), 1);
+        }
+
+        bool contains(const value &p) const {
+            return count(p) != 0;
+        }
+
+        // Copies of p inserted and not erased yet.
+        size_type count(const value &p) const {
+            if (_size == 0)
+                return 0;
+            return _slots[_find(radix_key(p.getX()), radix_key(p.getY()))].count;
+        }
+
+        // Drops one copy of p; the point itself goes with its last copy, by
+        // backward-shift deletion: later members of the probe run move up into
+        // the hole, so lookups never need tombstones.
+        void erase(const value &p) {
+            if (_size == 0)
+                return;
+
+            size_type mask = _slots.size() - 1;
+            size_type hole = _find(radix_key(p.getX()), radix_key(p.getY()));
+            if (_slots[hole].count == 0)
+                return;
+            if (--_slots[hole].count != 0)
+                return;
+
+            for (size_type i = (hole + 1) & mask; _slots[i].count != 0; i = (i + 1) & mask) {
+                size_type home = _hash(_slots[i].x, _slots[i].y) & mask;
+                // The slot may fill the hole unless its home lies cyclically in (hole, i].
+                if (((i - home) & mask) >= ((i - hole) & mask)) {
+                    _slots[hole] = _slots[i];
+                    hole = i;
+                }
+            }
+            _slots[hole].count = 0;
+            _size--;
+        }
+
+        // Empties the table but keeps its slots.
+        void clear() {
+            if (_size == 0)
+                return;
+            for (Slot &slot : _slots)
+                slot.count = 0;
+            _size = 0;
+        }
+
+        // Distinct points.
+        size_type size() const {
+            return _size;
+        }
+    };
+}
+
+
+#endif //GEOM_VERTEX_SET_H
@@ -0,0 +1,98 @@
+#ifndef GEOM_WRITER_H
+#define GEOM_WRITER_H
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#include "answers.h"
+
+namespace IO {
+    // Writes answers as text lines through one large buffer flushed with fwrite.
+    // Each byte of a packed answer word holds four answers, so a 256-entry table
+    // of preformatted four-line strings turns a word into eight memcpy calls.
+    class TextWriter {
+    private:
+        using size_type = size_t;
+
+        struct Lines {
+            char text[32];
+            uint8_t length;
+        };
+
+        static const size_type capacity = 1 << 16;
+
+        std::FILE *_file;
+        char _buffer[capacity];
+        size_type _used = 0;
+
+        static const char* _name(Geometry::State state) {
+            static const char *names[] = {"OUTSIDE\n", "INSIDE\n", "BORDER\n", ""};
+            return names[state];
+        }
+
+        static Lines _lines(int byte) {
+            Lines lines = {{}, 0};
+            for (int k = 0; k < 4; ++k) {
+                const char *name = _name(static_cast<Geometry::State>((byte >> (2 * k)) & 3));
+                std::memcpy(lines.text + lines.length, name, std::strlen(name));
+                lines.length += std::strlen(name);
+            }
+            return lines;
+        }
+
+        struct Table {
+            Lines lines[256];
+
+            Table() {
+                for (int byte = 0; byte < 256; ++byte)
+                    lines[byte] = _lines(byte);
+            }
+        };
+
+        void _reserve(size_type bytes) {
+            if (_used + bytes > capacity)
+                flush();
+        }
+    public:
+        explicit TextWriter(std::FILE *file) : _file(file) {}
+
+        TextWriter(const TextWriter&) = delete;
+        TextWriter& operator=(const TextWriter&) = delete;
+
+        ~TextWriter() {
+            flush();
+        }
+
+        void write(const Geometry::Answers &answers) {
+            static const Table table;
+            const uint64_t *words = answers.words();
+            size_type full = answers.size() / 4;
+
+            // Whole bytes first: four answers, at most 32 characters each step.
+            for (size_type b = 0; b < full; ++b) {
+                const Lines &lines = table.lines[(words[b / 8] >> (8 * (b % 8))) & 0xff];
+                _reserve(sizeof(lines.text));
+                std::memcpy(_buffer + _used, lines.text, sizeof(lines.text));
+                _used += lines.length;
+            }
+
+            for (size_type i = 4 * full; i < answers.size(); ++i) {
+                const char *name = _name(answers[i]);
+                size_type length = std::strlen(name);
+                _reserve(length);
+                std::memcpy(_buffer + _used, name, length);
+                _used += length;
+            }
+        }
+
+        void flush() {
+            if (_used != 0)
+                std::fwrite(_buffer, 1, _used, _file);
+            _used = 0;
+        }
+    };
+}
+
+
+#endif //GEOM_WRITER_H
@@ -1,226 +1,306 @@
 #include <iostream>
 #include <vector>
 #include <algorithm>
-#include <set>
+#include <fstream>
+#include <future>
+#include <string>
+#include <type_traits>
 
 #include "geometry.h"
+#include "scanner.h"
+#include "executor.h"
+#include "polygon_index.h"
+#include "belonging.h"
+#include "ray_casting.h"
+#include "convex.h"
+#include "trapezoid_map.h"
+#include "binary_format.h"
+#include "writer.h"
+#include "stats.h"
+
+enum class Mode {
+    BATCH,
+    STREAM,
+    PIPELINE,
+    PARALLEL,
+};
 
-template <class T>
-class MultiBelongingAlgorithm {
-private:
-    template <class U>
-    class Event {
-    public:
-        enum Type {
-            QUERY,
-            CLOSE,
-            OPEN,
-        };
-    private:
-        ssize_t _id;
-        Type type;
-        U p;
-    public:
-        Event(ssize_t id, Type type, U p) : _id(id), type(type), p(p) {}
-
-        const U& getPoint() const {
-            return p;
-        }
+enum class Engine {
+    AUTO,
+    SWEEP,
+    INDEX,
+    RAYCAST,
+    CONVEX,
+    TRAPEZOID,
+};
 
-        ssize_t getId() const {
-            return _id;
-        }
+enum class Layout {
+    AOS,
+    SOA,
+};
 
-        Type getType() const {
-            return type;
-        }
+enum class Coordinates {
+    DOUBLE,
+    INTEGER,
+};
 
-        bool operator<(const Event& other) const {
-            if (p.getX() == other.p.getX()) {
-                return type < other.type;
-            }
+enum class Format {
+    TEXT,
+    BINARY,
+};
 
-            return p.getX() < other.p.getX();
-        }
-    };
+inline const char* engine_name(Engine engine) {
+    switch (engine) {
+        case Engine::AUTO:
+            return "auto";
+        case Engine::SWEEP:
+            return "sweep";
+        case Engine::INDEX:
+            return "index";
+        case Engine::RAYCAST:
+            return "raycast";
+        case Engine::CONVEX:
+            return "convex";
+        case Engine::TRAPEZOID:
+            return "trapezoid";
+    }
+    return "";
+}
 
+struct Options {
+    Mode mode = Mode::BATCH;
+    // Picks ray casting below the RayCasting::preferable cutoff (doubles only,
+    // see Test::Prepare) and the sweep or a special engine above it.
+    Engine engine = Engine::AUTO;
+    Layout layout = Layout::AOS;
+    Coordinates coordinates = Coordinates::DOUBLE;
+    Format input_format = Format::TEXT;
+    Format output_format = Format::TEXT;
+    bool rings = false;
+    Geometry::FillRule fill = Geometry::FillRule::EVEN_ODD;
+    size_t threads = Parallel::hardware_threads();
+    size_t slabs = 1;
+    size_t grid = 0;
+    std::ostream *stats = nullptr;
+
+    // --threads is the pool that runs tests in parallel mode; in the other
+    // modes one test at a time may use it for sorting and the convex engine.
+    // --slabs only says how many x-slabs the sweep is cut into.
+    size_t test_threads() const {
+        return mode == Mode::PARALLEL ? 1 : threads;
+    }
+};
+
+template <class T>
+class Test {
+private:
     using value = T;
     using reference = T&;
     using const_reference = const T&;
     using pointer = T*;
     using size_type = size_t;
+    using coordinate = decltype(std::declval<const T&>().getX());
 
-    std::vector<value> _query;
-    std::vector<Geometry::State> _ans;
-
-    std::vector<Event<T>> _events;
-    Geometry::AdvancedPolygon<T> _polygon;
-    std::map<int, std::vector<T>> _x_points;
-
-    int _redirection(typename Event<T>::Type e) {
-        switch (e) {
-            case Event<T>::Type::OPEN:
-                return -1;
-            case Event<T>::Type::CLOSE:
-                return 1;
-            case Event<T>::Type::QUERY:
-                return 0;
-        }
-        return 0;
+    size_t _size;
+    Engine _engine = Engine::SWEEP;
+    MultiBelongingAlgorithm<value> *_algorithm = nullptr; // owned by _engine_for_thread()
+    Geometry::PolygonIndex<value> *_index = nullptr;
+    Geometry::RayCasting<value> *_raycast = nullptr;
+    Geometry::ConvexWedges<value> *_convex = nullptr;
+    Geometry::TrapezoidMap<value> *_trapezoids = nullptr;
+
+    // Prepare, Calculate and Clear of one test always run on the same thread, so
+    // every worker can keep a single sweep engine and reuse its buffers.
+    static MultiBelongingAlgorithm<value>& _engine_for_thread() {
+        static thread_local MultiBelongingAlgorithm<value> engine;
+        return engine;
     }
 
-    std::vector<Event<T>> _prepare(int x) {
-        std::vector<Event<T>> ev;
-        int j = 0;
-        for (Geometry::Edge<T> i : _polygon.getVerticalEdges()[x]) {
-            ev.push_back(Event<T>(j, Event<T>::Type::OPEN, i.minY()));
-            ev.push_back(Event<T>(j, Event<T>::Type::CLOSE, i.maxY()));
-            j++;
-        }
-
-        for (T i : _x_points[x]) {
-            ev.push_back(Event<T>(i.getId(), Event<T>::Type::QUERY, i));
-        }
-
-        return ev;
-    }
+    Geometry::Answers _ans;
+    Geometry::Points<value> _points, _queries;
+    std::vector<size_type> _rings;
+    Stats::Record _stats;
+public:
+    Test() = default;
 
-    void _peform(const std::vector<Event<T>> &ev) {
-        int balance = 0;
-        for (const Event<T>& i : ev) {
-            if (i.getType() == Event<T>::Type::OPEN)
-                balance++;
-            if (i.getType() == Event<T>::Type::CLOSE)
-                balance--;
-            if (i.getType() == Event<T>::Type::QUERY && balance > 0)
-                _ans[i.getId()] = Geometry::State::BORDER;
+    // With --rings the polygon is a ring count followed by every ring in the
+    // usual "n, then n points" form; the points are stored back to back.
+    template <class Stream>
+    void Input(Stream &is, const Options &options) {
+        GEOM_STATS_SCOPE(&_stats);
+        GEOM_STATS_TIMER(PARSE);
+        size_t rings = 1;
+        if (options.rings)
+            is >> rings;
+
+        _points.clear();
+        _rings.clear();
+        for (size_t r = 0; r < rings; ++r) {
+            is >> _size;
+            _rings.push_back(_points.size());
+            _points.reserve(_points.size() + _size);
+            for (size_t i = 0; i < _size; ++i) {
+                value p;
+                is >> p;
+                p.setId(_points.size());
+                _points.push_back(p);
+            }
         }
     }
 
-    void _answer_for_verticals() {
-        auto cmp = [=](Event<T> a, Event<T> b) {
-            if (a.getPoint().getY() == b.getPoint().getY()) {
-                return _redirection(a.getType()) < _redirection(b.getType());
-            }
-
-            return a.getPoint().getY() < b.getPoint().getY();
-        };
+    template <class Stream>
+    void Query(Stream &is) {
+        GEOM_STATS_SCOPE(&_stats);
+        GEOM_STATS_TIMER(PARSE);
+        is >> _size;
 
-        for (auto x : _x_points) {
-            std::vector<Event<T>> ev = std::move(_prepare(x.first));
-            sort(ev.begin(), ev.end(), cmp);
-            _peform(ev);
+        _queries.clear();
+        _queries.reserve(_size);
+        for (size_t i = 0; i < _size; ++i) {
+            value q;
+            is >> q;
+            q.setId(i);
+            _queries.push_back(q);
         }
     }
 
-    void _answer_for_others() {
-        auto cmp = [](const Geometry::Edge<T> &a, const Geometry::Edge<T> &b) {
-            double min_x = std::max(a.minX().getX(), b.minX().getX());
-            double max_x = std::min(a.maxX().getX(), b.maxX().getX());
-
-            double fleft_y = a.y(min_x), fright_y = b.y(min_x);
-            double sleft_y = a.y(max_x), sright_y = b.y(max_x);
-            return (fleft_y < fright_y || (fleft_y == fright_y && sleft_y < sright_y));
-        };
-        std::multiset<Geometry::Edge<T>, decltype(cmp)> open(cmp);
-
-        for (auto e : _events) {
-            switch (e.getType()) {
-                case Event<T>::OPEN:
-                    open.insert(_polygon.getEdges()[e.getId()]);
-                    break;
-                case Event<T>::CLOSE:
-                    open.erase(open.find(_polygon.getEdges()[e.getId()]));
-                    break;
-                case Event<T>::QUERY:
-                    if (open.empty())
-                        continue;
-                    Geometry::Edge<T> query(e.getPoint(), e.getPoint());
-
-                    auto it = open.lower_bound(query);
-                    if (it != open.end() && it->y(e.getPoint().getX()) == (double)e.getPoint().getY())
-                        _ans[e.getId()] = Geometry::State::BORDER;
-                    if (it != open.begin()) {
-                        --it;
-                        if (it->getPosition() == Geometry::Position::UP)
-                            _ans[e.getId()] = std::max(_ans[e.getId()], Geometry::State::INSIDE);
-                    }
-                    break;
-            }
-        }
+    // Binary input stores each point set as two coordinate columns.
+    void Input(IO::BinaryReader &is, const Options &) {
+        GEOM_STATS_SCOPE(&_stats);
+        GEOM_STATS_TIMER(PARSE);
+        is >> _size;
+        is.read<value>(_size, _points);
     }
-public:
-    MultiBelongingAlgorithm() = default;
 
-    MultiBelongingAlgorithm(const std::vector<value>& _points, const std::vector<value>& _queries) :
-                            _polygon(Geometry::AdvancedPolygon<T>(_points)) {
-        reserve_query(_queries.size());
-        for (auto q : _queries)
-            push_query(q);
+    void Query(IO::BinaryReader &is) {
+        GEOM_STATS_SCOPE(&_stats);
+        GEOM_STATS_TIMER(PARSE);
+        is >> _size;
+        is.read<value>(_size, _queries);
     }
 
-    void setOrder() {
-        if (_polygon.OrientArea() > 0) {
-            _polygon.revertOrder();
+    void Prepare(const Options &options) {
+        GEOM_STATS_SCOPE(&_stats);
+        _engine = options.engine;
+        if (_rings.size() > 1) {
+            // Only the sweep understands several rings.
+            _engine = Engine::SWEEP;
+        } else if (_engine == Engine::AUTO) {
+            // Ray casting works in doubles, so integer coordinates keep to the exact engines.
+            bool small = !std::is_integral<coordinate>::value &&
+                         Geometry::RayCasting<value>::preferable(_points.size(), _queries.size());
+            _engine = (small ? Engine::RAYCAST : Engine::CONVEX);
+        }
+        // AUTO picks the wedge engine too; it only takes convex polygons.
+        if (_engine == Engine::CONVEX && !Geometry::convex(_points))
+            _engine = Engine::SWEEP;
+
+        if (_engine == Engine::INDEX) {
+            GEOM_STATS_TIMER(BUILD);
+            _index = new Geometry::PolygonIndex<value>(_points);
+            return;
+        }
+        if (_engine == Engine::RAYCAST) {
+            GEOM_STATS_TIMER(BUILD);
+            _raycast = new Geometry::RayCasting<value>(_points);
+            return;
+        }
+        if (_engine == Engine::CONVEX) {
+            GEOM_STATS_TIMER(BUILD);
+            _convex = new Geometry::ConvexWedges<value>(_points);
+            return;
+        }
+        if (_engine == Engine::TRAPEZOID) {
+            GEOM_STATS_TIMER(BUILD);
+            _trapezoids = new Geometry::TrapezoidMap<value>(_points);
+            return;
+        }
+
+        {
+            GEOM_STATS_TIMER(BUILD);
+            _algorithm = &_engine_for_thread();
+            _algorithm->reset(_points, _queries);
+            if (_rings.size() > 1)
+                _algorithm->setRings(_rings, options.fill);
+            _algorithm->setGrid(options.grid);
         }
-    }
 
-    void run() {
-        _answer_for_verticals();
-        _answer_for_others();
+        _algorithm->setOrder();
+        _algorithm->setEdges();
+        _algorithm->setEvents();
+        _algorithm->sortEvents(options.test_threads());
     }
 
-    void setEvents() {
-        size_type id = 0;
-        for (auto e : _polygon.getEdges()) {
-            if (e.getPosition() != Geometry::Position::VERTICAL) {
-                _events.push_back(Event<T>(e.getId(), Event<T>::OPEN, e.minX()));
-                _events.push_back(Event<T>(e.getId(), Event<T>::CLOSE, e.maxX()));
-            }
-            id++;
+    void Calculate(const Options &options) {
+        GEOM_STATS_SCOPE(&_stats);
+        if (_engine == Engine::INDEX) {
+            GEOM_STATS_TIMER(QUERY);
+            _ans.resize(_queries.size());
+            for (size_type i = 0; i < _queries.size(); ++i)
+                _ans.set(i, _index->locate(_queries[i]));
+            return;
         }
-
-        for (auto e : _query) {
-            _events.push_back(Event<T>(e.getId(), Event<T>::QUERY, e));
+        if (_engine == Engine::RAYCAST) {
+            GEOM_STATS_TIMER(QUERY);
+            _ans = _raycast->run(_queries);
+            return;
+        }
+        if (_engine == Engine::CONVEX) {
+            GEOM_STATS_TIMER(QUERY);
+            _ans = _convex->run(_queries, options.test_threads());
+            return;
+        }
+        if (_engine == Engine::TRAPEZOID) {
+            GEOM_STATS_TIMER(QUERY);
+            _ans.resize(_queries.size());
+            for (size_type i = 0; i < _queries.size(); ++i)
+                _ans.set(i, _trapezoids->locate(_queries[i]));
+            return;
         }
-    }
 
-    void sortEvents() {
-        sort(_events.begin(), _events.end());
+        _algorithm->run(options.slabs);
+        _ans = _algorithm->take_ans();
     }
 
-    void setEdges() {
-        _polygon.setEdges();
+    void Output(IO::TextWriter &os) {
+        GEOM_STATS_SCOPE(&_stats);
+        GEOM_STATS_TIMER(OUTPUT);
+        os.write(_ans);
     }
 
-    void reserve_query(size_type size) {
-        _query.reserve(size);
-        _ans.resize(size);
+    void Output(IO::AnswerWriter &os) {
+        GEOM_STATS_SCOPE(&_stats);
+        GEOM_STATS_TIMER(OUTPUT);
+        os.write(_ans);
     }
 
-    template <class U>
-    void push_query(U&& p) {
-        if (_polygon.getVerticies().count(std::forward<T>(p)))
-            _ans[p.getId()] = Geometry::State::BORDER;
-
-        _query.push_back(std::forward<T>(p));
-        _x_points[p.getX()].push_back(std::forward<T>(p));
+    void Clear() {
+        delete _index;
+        delete _raycast;
+        delete _convex;
+        delete _trapezoids;
+        _algorithm = nullptr;
+        _index = nullptr;
+        _raycast = nullptr;
+        _convex = nullptr;
+        _trapezoids = nullptr;
     }
 
-    void clear() {
-        _query.clear();
-        _ans.clear();
-        _events.clear();
-        _x_points.clear();
+    size_type weight() const {
+        return _points.size() + _queries.size();
     }
 
-    std::vector<Geometry::State> ans() const {
-        return _ans;
+    // One JSON line with the sizes, the engine used and the collected stats.
+    void Report(std::ostream &os, size_type index) const {
+        os << "{\"test\":" << index << ",\"engine\":\"" << engine_name(_engine) << "\",\"n\":" << _points.size()
+           << ",\"m\":" << _queries.size() << ',';
+        _stats.write(os);
+        os << "}\n";
     }
 };
 
 template <class T>
-class Test {
+class TestCase {
 private:
     using value = T;
     using reference = T&;
@@ -229,116 +309,319 @@ private:
     using size_type = size_t;
 
     size_t _size;
-    MultiBelongingAlgorithm<value> *_algorithm;
-
-    std::string _serialize(Geometry::State state) {
-        switch (state) {
-            case Geometry::State::INSIDE:
-                return "INSIDE";
-            case Geometry::State::OUTSIDE:
-                return "OUTSIDE";
-            case Geometry::State::BORDER:
-                return "BORDER";
-        }
-
-    }
-
-    std::vector<Geometry::State> _ans;
-    std::vector<value> _points, _queries;
+    std::vector<Test<T>> _tests;
 public:
-    Test() = default;
-
-    void Input(std::istream &is) {
-        is >> _size;
+    TestCase() = default;
 
-        _points.resize(_size);
-        for (size_t i = 0; i < _size; ++i) {
-            is >> _points[i];
-            _points[i].setId(i);
-        }
+    TestCase(size_t _size) : _size(_size) {
+        _tests.resize(_size);
     }
 
-    void Query(std::istream &is) {
-        is >> _size;
+    size_type size() const {
+        return _size;
+    }
 
-        _queries.resize(_size);
-        for (size_t i = 0; i < _size; ++i) {
-            is >> _queries[i];
-            _queries[i].setId(i);
-        }
+    Test<T>& operator[](int index) {
+        return _tests[index];
     }
+};
 
-    void Prepare() {
-        _algorithm = new MultiBelongingAlgorithm<value>(_points, _queries);
+template <class T, class Stream, class Sink>
+void solve(Stream &is, Sink &os, const Options &options) {
+    uint32_t tests;
+    is >> tests;
 
-        _algorithm->setOrder();
-        _algorithm->setEdges();
-        _algorithm->setEvents();
-        _algorithm->sortEvents();
+    TestCase<T> test(tests);
+    for (int i = 0; i < tests; ++i) {
+        test[i].Input(is, options);
+        test[i].Query(is);
     }
 
-    void Calculate() {
-        _algorithm->run();
-        _ans = _algorithm->ans();
+    for (int i = 0; i < tests; ++i) {
+        test[i].Prepare(options);
+        test[i].Calculate(options);
+        test[i].Clear();
     }
 
-    void Output(std::ostream &os) {
-        for (auto state : _ans) {
-            os << _serialize(state) << '\n';
-        }
+    for (int i = 0; i < tests; ++i) {
+        test[i].Output(os);
+        if (options.stats)
+            test[i].Report(*options.stats, i);
     }
 
-    void Clear() {
-        delete _algorithm;
-    }
-};
+}
 
-template <class T>
-class TestCase {
-private:
-    using value = T;
-    using reference = T&;
-    using const_reference = const T&;
-    using pointer = T*;
-    using size_type = size_t;
+template <class T, class Stream>
+Test<T> read_test(Stream &is, const Options &options) {
+    Test<T> test;
+    test.Input(is, options);
+    test.Query(is);
+    return test;
+}
 
-    size_t _size;
-    std::vector<Test<T>> _tests;
-public:
-    TestCase() = default;
+// Keeps a single test alive at a time, so memory is bounded by the largest test.
+template <class T, class Stream, class Sink>
+void solve_stream(Stream &is, Sink &os, const Options &options) {
+    uint32_t tests;
+    is >> tests;
 
-    TestCase(size_t _size) {
-        _tests.resize(_size);
+    for (uint32_t i = 0; i < tests; ++i) {
+        Test<T> test = read_test<T>(is, options);
+        test.Prepare(options);
+        test.Calculate(options);
+        test.Clear();
+        test.Output(os);
+        if (options.stats)
+            test.Report(*options.stats, i);
     }
+}
 
-    Test<T>& operator[](int index) {
-        return _tests[index];
+// Like solve_stream, but parses test i + 1 on a second thread while test i is computed.
+template <class T, class Stream, class Sink>
+void solve_pipeline(Stream &is, Sink &os, const Options &options) {
+    uint32_t tests;
+    is >> tests;
+    if (tests == 0)
+        return;
+
+    auto reader = [&is, &options]() {
+        return read_test<T>(is, options);
+    };
+
+    std::future<Test<T>> next = std::async(std::launch::async, reader);
+    for (uint32_t i = 0; i < tests; ++i) {
+        Test<T> test = next.get();
+        if (i + 1 < tests)
+            next = std::async(std::launch::async, reader);
+
+        test.Prepare(options);
+        test.Calculate(options);
+        test.Clear();
+        test.Output(os);
+        if (options.stats)
+            test.Report(*options.stats, i);
     }
-};
+}
 
-void solve(std::istream &is, std::ostream &os) {
+// Reads every test, spreads Prepare/Calculate over a work-stealing pool and
+// prints the answers in input order.
+template <class T, class Stream, class Sink>
+void solve_parallel(Stream &is, Sink &os, const Options &options) {
     uint32_t tests;
     is >> tests;
 
-    TestCase<Geometry::Point<double>> test(tests);
-    for (int i = 0; i < tests; ++i) {
-        test[i].Input(is);
+    TestCase<T> test(tests);
+    std::vector<size_t> weights(tests);
+    for (uint32_t i = 0; i < tests; ++i) {
+        test[i].Input(is, options);
         test[i].Query(is);
+        weights[i] = test[i].weight();
     }
 
-    for (int i = 0; i < tests; ++i) {
-        test[i].Prepare();
-        test[i].Calculate();
+    Parallel::WorkStealingExecutor executor(options.threads);
+    executor.run(weights, [&test, &options](size_t i) {
+        test[i].Prepare(options);
+        test[i].Calculate(options);
         test[i].Clear();
+    });
+
+    for (uint32_t i = 0; i < tests; ++i) {
+        test[i].Output(os);
+        if (options.stats)
+            test[i].Report(*options.stats, i);
     }
+}
 
-    for (int i = 0; i < tests; ++i) {
-        test[i].Output(std::cout);
+template <class T, class Stream, class Sink>
+void run(Stream &is, Sink &os, const Options &options) {
+    switch (options.mode) {
+        case Mode::BATCH:
+            solve<T>(is, os, options);
+            break;
+        case Mode::STREAM:
+            solve_stream<T>(is, os, options);
+            break;
+        case Mode::PIPELINE:
+            solve_pipeline<T>(is, os, options);
+            break;
+        case Mode::PARALLEL:
+            solve_parallel<T>(is, os, options);
+            break;
+    }
+}
+
+template <class C, class Stream, class Sink>
+void dispatch_layout(Stream &is, Sink &os, const Options &options) {
+    switch (options.layout) {
+        case Layout::AOS:
+            run<Geometry::Point<C>>(is, os, options);
+            break;
+        case Layout::SOA:
+            run<Geometry::ColumnPoint<C>>(is, os, options);
+            break;
+    }
+}
+
+// Integer coordinates get exact predicates (see Geometry::Segment::side).
+template <class Stream, class Sink>
+void dispatch(Stream &is, Sink &os, const Options &options) {
+    switch (options.coordinates) {
+        case Coordinates::DOUBLE:
+            dispatch_layout<double>(is, os, options);
+            break;
+        case Coordinates::INTEGER:
+            dispatch_layout<int64_t>(is, os, options);
+            break;
+    }
+}
+
+template <class Stream>
+void dispatch_output(Stream &is, const Options &options) {
+    if (options.output_format == Format::BINARY) {
+        IO::AnswerWriter writer(std::cout);
+        dispatch(is, writer, options);
+    } else {
+        IO::TextWriter writer(stdout);
+        dispatch(is, writer, options);
     }
+}
+
+// The prefilter grid has grid * grid cells; 4096 keeps it at 16M bytes.
+static const size_t max_grid = 4096;
+// Threads and slabs beyond this only add overhead.
+static const size_t max_threads = 1024;
+
+void usage() {
+    std::cerr << "usage: geom [--mode=batch|stream|pipeline|parallel] [--engine=auto|sweep|index|raycast|convex|trapezoid]\n"
+              << "            [--layout=aos|soa] [--coords=double|int] [--threads=N] [--slabs=K] [--grid=N]\n"
+              << "            [--input-format=text|binary] [--output-format=text|binary] [--stats=FILE]\n"
+              << "            [--rings [--fill=evenodd|nonzero]]\n";
+}
 
+// Reads the value of a --name=N option: decimal digits only, at most max.
+bool parse_count(const std::string &arg, size_t prefix, size_t max, size_t &value) {
+    std::string digits = arg.substr(prefix);
+    bool valid = !digits.empty() && digits.size() <= 9 &&
+                 digits.find_first_not_of("0123456789") == std::string::npos;
+    if (valid)
+        value = std::stoul(digits);
+    if (!valid || value > max) {
+        std::cerr << arg.substr(0, prefix - 1) << " takes a number from 0 to " << max << ", got '" << digits << "'\n";
+        usage();
+        return false;
+    }
+    return true;
 }
 
-int main() {
-    solve(std::cin, std::cout);
+bool parse_options(int argc, char **argv, Options &options, std::ofstream &stats) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--mode=batch") {
+            options.mode = Mode::BATCH;
+        } else if (arg == "--mode=stream") {
+            options.mode = Mode::STREAM;
+        } else if (arg == "--mode=pipeline") {
+            options.mode = Mode::PIPELINE;
+        } else if (arg == "--mode=parallel") {
+            options.mode = Mode::PARALLEL;
+        } else if (arg == "--engine=auto") {
+            options.engine = Engine::AUTO;
+        } else if (arg == "--engine=sweep") {
+            options.engine = Engine::SWEEP;
+        } else if (arg == "--engine=index") {
+            options.engine = Engine::INDEX;
+        } else if (arg == "--engine=raycast") {
+            options.engine = Engine::RAYCAST;
+        } else if (arg == "--engine=convex") {
+            options.engine = Engine::CONVEX;
+        } else if (arg == "--engine=trapezoid") {
+            options.engine = Engine::TRAPEZOID;
+        } else if (arg == "--layout=aos") {
+            options.layout = Layout::AOS;
+        } else if (arg == "--layout=soa") {
+            options.layout = Layout::SOA;
+        } else if (arg == "--coords=double") {
+            options.coordinates = Coordinates::DOUBLE;
+        } else if (arg == "--coords=int") {
+            options.coordinates = Coordinates::INTEGER;
+        } else if (arg == "--input-format=text") {
+            options.input_format = Format::TEXT;
+        } else if (arg == "--input-format=binary") {
+            options.input_format = Format::BINARY;
+        } else if (arg == "--output-format=text") {
+            options.output_format = Format::TEXT;
+        } else if (arg == "--output-format=binary") {
+            options.output_format = Format::BINARY;
+        } else if (arg == "--rings") {
+            options.rings = true;
+        } else if (arg == "--fill=evenodd") {
+            options.fill = Geometry::FillRule::EVEN_ODD;
+        } else if (arg == "--fill=nonzero") {
+            options.fill = Geometry::FillRule::NONZERO;
+        } else if (arg.compare(0, 10, "--threads=") == 0) {
+            if (!parse_count(arg, 10, max_threads, options.threads))
+                return false;
+            options.threads = std::max<size_t>(options.threads, 1);
+        } else if (arg.compare(0, 8, "--slabs=") == 0) {
+            if (!parse_count(arg, 8, max_threads, options.slabs))
+                return false;
+            options.slabs = std::max<size_t>(options.slabs, 1);
+        } else if (arg.compare(0, 7, "--grid=") == 0) {
+            if (!parse_count(arg, 7, max_grid, options.grid))
+                return false;
+        } else if (arg.compare(0, 8, "--stats=") == 0) {
+#ifdef GEOM_STATS
+            stats.open(arg.substr(8));
+            if (!stats) {
+                std::cerr << "cannot open " << arg.substr(8) << '\n';
+                return false;
+            }
+            options.stats = &stats;
+#else
+            (void)stats;
+            std::cerr << "--stats needs a build with -DGEOM_STATS=ON\n";
+            return false;
+#endif
+        } else {
+            std::cerr << "unknown option " << arg << '\n';
+            usage();
+            return false;
+        }
+    }
+
+    if (options.rings && options.input_format == Format::BINARY) {
+        std::cerr << "--rings needs text input: the binary format holds one ring per polygon\n";
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char **argv) {
+    Options options;
+    std::ofstream stats;
+    if (!parse_options(argc, argv, options, stats))
+        return 1;
+
+    if (options.input_format == Format::BINARY) {
+        IO::InputBuffer input(STDIN_FILENO);
+        IO::BinaryReader reader(input.begin(), input.end());
+        if (!reader) {
+            std::cerr << "not a binary test file (version " << IO::Binary::version << ")\n";
+            return 1;
+        }
+        // The file says what its coordinates are.
+        bool integer = (reader.coordinates() == IO::Binary::INT64);
+        options.coordinates = (integer ? Coordinates::INTEGER : Coordinates::DOUBLE);
+        dispatch_output(reader, options);
+        return 0;
+    }
+
+    IO::MappedFile input(STDIN_FILENO);
+    if (input.isMapped()) {
+        IO::Scanner scanner(input.begin(), input.end());
+        dispatch_output(scanner, options);
+    } else {
+        dispatch_output(std::cin, options);
+    }
     return 0;
-}
\ No newline at end of file
+}
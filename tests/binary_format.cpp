@@ -0,0 +1,89 @@
+#include <cstdint>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "binary_format.h"
+#include "check.h"
+
+template <class C>
+static std::vector<Geometry::Point<C>> points(const std::vector<C> &coordinates) {
+    std::vector<Geometry::Point<C>> result;
+    for (size_t i = 0; i + 1 < coordinates.size(); i += 2)
+        result.push_back(Geometry::Point<C>(coordinates[i], coordinates[i + 1], result.size()));
+    return result;
+}
+
+// Two point sets written by BinaryWriter come back bit for bit, with ids 0..n-1.
+template <class C>
+static void tests_round_trip(const std::vector<C> &coordinates, IO::Binary::Coordinates type) {
+    std::vector<Geometry::Point<C>> polygon = points(coordinates), queries = points(std::vector<C>());
+    std::ostringstream os;
+    IO::BinaryWriter writer(os, type, 1);
+    writer.write(polygon);
+    writer.write(queries);
+    std::string file = os.str();
+
+    IO::BinaryReader reader(file.data(), file.data() + file.size());
+    CHECK(reader);
+    CHECK(reader.coordinates() == type);
+    uint64_t tests = 0;
+    size_t n = 0, m = 0;
+    std::vector<Geometry::Point<C>> read;
+    reader >> tests >> n;
+    reader.read<Geometry::Point<C>>(n, read);
+    CHECK(tests == 1);
+    CHECK(read.size() == polygon.size());
+    for (size_t i = 0; i < read.size() && i < polygon.size(); ++i) {
+        CHECK(read[i] == polygon[i]);
+        CHECK(read[i].getId() == i);
+    }
+    reader >> m;
+    reader.read<Geometry::Point<C>>(m, read);
+    CHECK(reader);
+    CHECK(m == 0 && read.empty());
+
+    // Any cut through the file is reported, never read past.
+    for (size_t cut = 0; cut < file.size(); cut += 5) {
+        IO::BinaryReader truncated(file.data(), file.data() + cut);
+        truncated >> tests >> n;
+        truncated.read<Geometry::Point<C>>(n, read);
+        truncated >> m;
+        CHECK(!truncated);
+    }
+}
+
+// Answers written packed and unpacked read back the same, record by record.
+static void answers_round_trip() {
+    std::vector<Geometry::State> first, second;
+    for (size_t i = 0; i < 100; ++i)
+        first.push_back(static_cast<Geometry::State>(i * 7 % 3));
+    second.push_back(Geometry::State::BORDER);
+
+    std::ostringstream os;
+    IO::AnswerWriter writer(os);
+    writer.write(first);
+    writer.write(Geometry::Answers(second));
+    writer.write(std::vector<Geometry::State>());
+    std::string file = os.str();
+
+    IO::AnswerReader reader(file.data(), file.data() + file.size());
+    std::vector<Geometry::State> read;
+    CHECK(reader.read(read) && read == first);
+    CHECK(reader.read(read) && read == second);
+    CHECK(reader.read(read) && read.empty());
+    CHECK(!reader.read(read) && !reader.failed());
+
+    IO::AnswerReader truncated(file.data(), file.data() + 16 + 8 + 8);
+    CHECK(!truncated.read(read) && truncated.failed());
+}
+
+int main() {
+    const double huge = std::numeric_limits<double>::max(), tiny = std::numeric_limits<double>::denorm_min();
+    tests_round_trip<double>({0.1, -0.0, huge, -huge, tiny, 1e-300, 3, 4}, IO::Binary::FLOAT64);
+    const int64_t max = std::numeric_limits<int64_t>::max(), min = std::numeric_limits<int64_t>::min();
+    tests_round_trip<int64_t>({0, -1, max, min, 1, 2}, IO::Binary::INT64);
+    answers_round_trip();
+    return Check::result();
+}
@@ -0,0 +1,30 @@
+#ifndef GEOM_TESTS_CHECK_H
+#define GEOM_TESTS_CHECK_H
+
+#include <iostream>
+
+// Minimal assertions for the test executables: a failed CHECK reports its
+// line and the test exits non-zero at the end of main.
+namespace Check {
+    inline int& failures() {
+        static int count = 0;
+        return count;
+    }
+
+    inline int result() {
+        if (failures() != 0)
+            std::cerr << failures() << " check(s) failed\n";
+        return failures() != 0;
+    }
+}
+
+#define CHECK(condition)                                                                   \
+    do {                                                                                   \
+        if (!(condition)) {                                                                \
+            std::cerr << __FILE__ << ':' << __LINE__ << ": CHECK(" #condition ") failed\n"; \
+            Check::failures()++;                                                           \
+        }                                                                                  \
+    } while (0)
+
+
+#endif //GEOM_TESTS_CHECK_H
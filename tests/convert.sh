@@ -0,0 +1,56 @@
+#!/bin/sh
+# usage: convert.sh <geom> <geom_convert>
+# Converts a text test file to binary and back, and checks that geom answers
+# the text file, its binary form and the converted-back text alike, with the
+# binary answers converted to text.
+set -e
+geom=$1
+convert=$2
+dir=$(mktemp -d)
+trap 'rm -rf "$dir"' EXIT
+
+cat > "$dir/tests.txt" <<'TESTS'
+2
+6
+2 -4
+2 3
+0 3
+0 2
+-2 2
+-2 -4
+6
+2 3
+1 0
+0 2
+-2 -4
+3 0
+-1 -1
+4
+0.1 0.1
+0.7 0.1
+0.7 0.7
+0.1 0.7
+4
+0.4 0.4
+0.1 0.3
+0.7 0.70000000000000007
+0.8 0.2
+TESTS
+
+for coords in double int; do
+    input="$dir/tests.txt"
+    if [ $coords = int ]; then
+        head -n 15 "$dir/tests.txt" | sed '1s/.*/1/' > "$dir/int.txt"
+        input="$dir/int.txt"
+    fi
+    "$geom" --coords=$coords < "$input" > "$dir/expected.txt"
+    "$convert" tests-to-binary $coords < "$input" > "$dir/tests.bin"
+    "$convert" tests-to-text < "$dir/tests.bin" > "$dir/back.txt"
+    "$geom" --coords=$coords < "$dir/back.txt" > "$dir/back_answers.txt"
+    "$geom" --input-format=binary --output-format=binary < "$dir/tests.bin" > "$dir/answers.bin"
+    "$convert" answers-to-text < "$dir/answers.bin" > "$dir/answers.txt"
+    "$convert" answers-to-binary < "$dir/expected.txt" | "$convert" answers-to-text > "$dir/again.txt"
+    cmp "$dir/expected.txt" "$dir/back_answers.txt"
+    cmp "$dir/expected.txt" "$dir/answers.txt"
+    cmp "$dir/expected.txt" "$dir/again.txt"
+done
@@ -0,0 +1,89 @@
+#include <vector>
+
+#include "arena.h"
+#include "belonging.h"
+#include "check.h"
+#include "reference.h"
+
+using Reference::Point;
+using Column = Geometry::ColumnPoint<double>;
+
+template <class T>
+static Geometry::Points<T> convert(const Geometry::Points<Point> &points) {
+    Geometry::Points<T> result;
+    for (const Point &p : points)
+        result.push_back(T(p));
+    return result;
+}
+
+// Every answer must match a fresh sweep of the edited polygon.
+template <class T, class Status>
+static void same_as_fresh(const MultiBelongingAlgorithm<T, Status> &algorithm, const Geometry::Points<Point> &queries) {
+    Geometry::Points<Point> points;
+    for (T p : algorithm.polygon().getPoints())
+        points.push_back(Point(p.getX(), p.getY(), p.getId()));
+    CHECK(algorithm.ans() == Reference::sweep(points, queries));
+}
+
+template <class T, class Status>
+static size_t find(const MultiBelongingAlgorithm<T, Status> &algorithm, double x, double y) {
+    const Geometry::Points<T> &points = algorithm.polygon().getPoints();
+    for (size_t i = 0; i < points.size(); ++i) {
+        if (points[i].getX() == x && points[i].getY() == y)
+            return i;
+    }
+    CHECK(false);
+    return 0;
+}
+
+// Moves, inserts and erases vertices, making and breaking vertical edges, and
+// checks every query after each edit.
+template <class T, class Status = Geometry::BlockStatus<T>>
+static void edits() {
+    Geometry::Points<Point> roof = Reference::polygon({{0, 0}, {20, 0}, {20, 10}, {15, 11}, {10, 10}, {5, 11}, {0, 10}});
+    Geometry::Points<Point> queries = Reference::lattice(-1, 21, 0.5);
+    MultiBelongingAlgorithm<T, Status> algorithm(convert<T>(roof), convert<T>(queries));
+    algorithm.setOrder();
+    algorithm.setEdges();
+    algorithm.setEvents();
+    algorithm.sortEvents();
+    algorithm.run();
+    same_as_fresh(algorithm, queries);
+
+    algorithm.moveVertex(find(algorithm, 15, 11), T(Point(15, 13, 0)));
+    same_as_fresh(algorithm, queries);
+    algorithm.insertVertex(find(algorithm, 10, 10), T(Point(7, 12, 0)));
+    same_as_fresh(algorithm, queries);
+    algorithm.moveVertex(find(algorithm, 20, 10), T(Point(18, 10, 0)));
+    same_as_fresh(algorithm, queries);
+    algorithm.insertVertex(find(algorithm, 18, 10), T(Point(18, 5, 0)));
+    same_as_fresh(algorithm, queries);
+    algorithm.eraseVertex(find(algorithm, 5, 11));
+    same_as_fresh(algorithm, queries);
+    algorithm.moveVertex(find(algorithm, 18, 10), T(Point(20, 10, 0)));
+    same_as_fresh(algorithm, queries);
+
+    algorithm.run();
+    same_as_fresh(algorithm, queries);
+}
+
+// Repeated edits must not keep allocating from the arena the polygon started on.
+static void arena_stays_bounded() {
+    Memory::Arena arena;
+    Geometry::AdvancedPolygon<Point> polygon(Reference::polygon({{0, 0}, {0, 10}, {10, 10}, {10, 0}}), &arena);
+    polygon.setEdges();
+    size_t capacity = arena.capacity();
+    for (int k = 0; k < 100000; ++k) {
+        polygon.moveVertex(1, Point(k % 2, 10, 1));
+        polygon.moveVertex(2, Point(10, 10 + k % 2, 2));
+    }
+    CHECK(arena.capacity() == capacity);
+}
+
+int main() {
+    edits<Point>();
+    edits<Point, Geometry::MultisetStatus<Point>>();
+    edits<Column>();
+    arena_stays_bounded();
+    return Check::result();
+}
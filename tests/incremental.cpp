@@ -0,0 +1,88 @@
+#include <vector>
+
+#include "belonging.h"
+#include "check.h"
+#include "reference.h"
+
+using Reference::Point;
+using Reference::polygon;
+
+static void prepare(MultiBelongingAlgorithm<Point> &algorithm) {
+    algorithm.setOrder();
+    algorithm.setEdges();
+    algorithm.setEvents();
+    algorithm.sortEvents();
+    algorithm.run();
+}
+
+// Every live answer must match a fresh sweep of the current polygon over the
+// live queries; erased ones read OUTSIDE.
+static void same_as_fresh(const MultiBelongingAlgorithm<Point> &algorithm) {
+    Geometry::Points<Point> live;
+    std::vector<size_t> ids;
+    for (size_t id = 0; id < algorithm.ans().size(); ++id) {
+        if (algorithm.erased(id)) {
+            CHECK(algorithm.ans()[id] == Geometry::State::OUTSIDE);
+            continue;
+        }
+        Point q = algorithm.query(id);
+        q.setId(live.size());
+        live.push_back(q);
+        ids.push_back(id);
+    }
+
+    Geometry::Answers expected = Reference::sweep(algorithm.polygon().getPoints(), live);
+    for (size_t i = 0; i < ids.size(); ++i)
+        CHECK(algorithm.ans()[ids[i]] == expected[i]);
+}
+
+// Inserts and erases between updates, across the point where update() compacts.
+static void insert_erase_update() {
+    Geometry::Points<Point> star = polygon({{0, 0}, {5, 2}, {10, 0}, {8, 5}, {10, 10}, {5, 8}, {0, 10}, {2, 5}});
+    MultiBelongingAlgorithm<Point> algorithm(star, Reference::lattice(-1, 11, 1));
+    prepare(algorithm);
+
+    for (int round = 0; round < 6; ++round) {
+        for (int k = 0; k < 40; ++k)
+            algorithm.insert_query(Point((k * 7 + round) % 23 * 0.5 - 1, (k * 11 + round * 3) % 23 * 0.5 - 1, 0));
+        for (size_t id = round; id < algorithm.ans().size(); id += 9)
+            algorithm.erase_query(id);
+        algorithm.update();
+        same_as_fresh(algorithm);
+    }
+    algorithm.run();
+    same_as_fresh(algorithm);
+}
+
+// Queries inserted before a vertex edit and answered by the update() after
+// it, inside and outside the edited span, whether or not an update() came
+// in between.
+static void insert_edit_update() {
+    Geometry::Points<Point> roof = polygon({{0, 0}, {20, 0}, {20, 10}, {15, 11}, {10, 10}, {5, 11}, {0, 10}});
+    MultiBelongingAlgorithm<Point> algorithm(roof, Reference::lattice(0, 20, 5));
+    prepare(algorithm);
+
+    size_t located = algorithm.insert_query(Point(3, 3, 0));
+    algorithm.update();
+    size_t far = algorithm.insert_query(Point(2, 2, 0));
+    size_t near = algorithm.insert_query(Point(15, 11.5, 0));
+    for (size_t i = 0; i < algorithm.polygon().getPoints().size(); ++i) {
+        const Point &p = algorithm.polygon().getPoints()[i];
+        if (p.getX() == 15 && p.getY() == 11)
+            algorithm.moveVertex(i, Point(15, 12, p.getId()));
+    }
+    algorithm.update();
+
+    CHECK(algorithm.ans()[located] == Geometry::State::INSIDE);
+    CHECK(algorithm.ans()[far] == Geometry::State::INSIDE);
+    CHECK(algorithm.ans()[near] == Geometry::State::INSIDE);
+    same_as_fresh(algorithm);
+    algorithm.run();
+    same_as_fresh(algorithm);
+}
+
+int main() {
+    insert_erase_update();
+    insert_edit_update();
+    return Check::result();
+}
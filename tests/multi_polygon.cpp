@@ -0,0 +1,34 @@
+#include <vector>
+
+#include "check.h"
+#include "multi_polygon.h"
+#include "reference.h"
+
+using Reference::Point;
+using Reference::polygon;
+
+int main() {
+    // Overlapping zones with vertical edges, shared vertices and a clockwise
+    // ring, plus an empty polygon that must never be hit.
+    std::vector<Geometry::Points<Point>> zones = {
+            polygon({{0, 0}, {6, 0}, {6, 6}, {0, 6}}),
+            polygon({{2, 2}, {2, 10}, {10, 10}, {10, 2}}),
+            polygon({{0, 0}, {8, 4}, {0, 8}}),
+            {},
+            polygon({{4, 1}, {9, 1}, {9, 3}, {6, 3}, {6, 8}, {4, 8}}),
+    };
+
+    // Every half-integer lattice point, so vertices, edges and interiors all occur.
+    Geometry::Points<Point> queries = Reference::lattice(-1, 11, 0.5);
+
+    MultiPolygonAlgorithm<Point> algorithm(zones, queries);
+    algorithm.run();
+    std::vector<Geometry::Answers> matrix = algorithm.matrix();
+    CHECK(matrix.size() == zones.size());
+    for (size_t k = 0; k < zones.size() && k < matrix.size(); ++k)
+        CHECK(matrix[k] == Reference::sweep(zones[k], queries));
+
+    for (const auto &hit : algorithm.hits())
+        CHECK(hit.polygon != 3);
+    return Check::result();
+}
@@ -0,0 +1,45 @@
+#ifndef GEOM_TESTS_REFERENCE_H
+#define GEOM_TESTS_REFERENCE_H
+
+#include <utility>
+#include <vector>
+
+#include "belonging.h"
+
+// Helpers shared by the tests that compare an engine with a fresh full sweep.
+namespace Reference {
+    using Point = Geometry::Point<double>;
+
+    inline Geometry::Points<Point> polygon(const std::vector<std::pair<double, double>> &coordinates) {
+        Geometry::Points<Point> points;
+        for (const auto &c : coordinates)
+            points.push_back(Point(c.first, c.second, points.size()));
+        return points;
+    }
+
+    // Every point of the step-by-step lattice over [low, high]^2, numbered from 0.
+    inline Geometry::Points<Point> lattice(double low, double high, double step) {
+        Geometry::Points<Point> queries;
+        for (double x = low; x <= high; x += step) {
+            for (double y = low; y <= high; y += step)
+                queries.push_back(Point(x, y, queries.size()));
+        }
+        return queries;
+    }
+
+    // One setOrder .. run pass of a new engine; an empty polygon contains nothing.
+    inline Geometry::Answers sweep(const Geometry::Points<Point> &points, const Geometry::Points<Point> &queries) {
+        if (points.empty())
+            return Geometry::Answers(queries.size());
+        MultiBelongingAlgorithm<Point> algorithm(points, queries);
+        algorithm.setOrder();
+        algorithm.setEdges();
+        algorithm.setEvents();
+        algorithm.sortEvents();
+        algorithm.run();
+        return algorithm.take_ans();
+    }
+}
+
+
+#endif //GEOM_TESTS_REFERENCE_H
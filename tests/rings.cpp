@@ -0,0 +1,77 @@
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "belonging.h"
+#include "check.h"
+#include "reference.h"
+
+using Reference::Point;
+
+struct Ring {
+    std::vector<std::pair<double, double>> points;
+};
+
+// The answer by definition: BORDER on any edge, otherwise the crossing count
+// (even-odd) or the winding number (nonzero) of a rightward ray.
+static Geometry::State expected(const std::vector<Ring> &rings, const Point &q, Geometry::FillRule rule) {
+    int crossings = 0, winding = 0;
+    for (const Ring &ring : rings) {
+        for (size_t i = 0; i < ring.points.size(); ++i) {
+            auto a = ring.points[i], b = ring.points[(i + 1) % ring.points.size()];
+            double cross = (b.first - a.first) * (q.getY() - a.second) - (b.second - a.second) * (q.getX() - a.first);
+            if (cross == 0 && std::min(a.first, b.first) <= q.getX() && q.getX() <= std::max(a.first, b.first) &&
+                std::min(a.second, b.second) <= q.getY() && q.getY() <= std::max(a.second, b.second))
+                return Geometry::State::BORDER;
+            if (a.second <= q.getY() && q.getY() < b.second && cross > 0) {
+                ++crossings;
+                ++winding;
+            } else if (b.second <= q.getY() && q.getY() < a.second && cross < 0) {
+                ++crossings;
+                --winding;
+            }
+        }
+    }
+    bool inside = (rule == Geometry::FillRule::EVEN_ODD ? crossings % 2 != 0 : winding != 0);
+    return inside ? Geometry::State::INSIDE : Geometry::State::OUTSIDE;
+}
+
+static void same_as_definition(const std::vector<Ring> &rings, Geometry::FillRule rule) {
+    Geometry::Points<Point> points;
+    std::vector<size_t> starts;
+    for (const Ring &ring : rings) {
+        starts.push_back(points.size());
+        for (const auto &c : ring.points)
+            points.push_back(Point(c.first, c.second, points.size()));
+    }
+    Geometry::Points<Point> queries = Reference::lattice(-1, 13, 0.5);
+
+    MultiBelongingAlgorithm<Point> algorithm(points, queries);
+    algorithm.setRings(starts, rule);
+    algorithm.setOrder();
+    algorithm.setEdges();
+    algorithm.setEvents();
+    algorithm.sortEvents();
+    algorithm.run();
+    for (const Point &q : queries)
+        CHECK(algorithm.ans()[q.getId()] == expected(rings, q, rule));
+}
+
+int main() {
+    Ring outer{{{0, 0}, {12, 0}, {12, 12}, {0, 12}}};
+    Ring hole{{{2, 2}, {2, 10}, {10, 10}, {10, 2}}};
+    Ring same{{{2, 2}, {10, 2}, {10, 10}, {2, 10}}};
+    Ring island{{{4, 4}, {8, 4}, {6, 8}}};
+    Ring apart{{{13, 0}, {13, 4}, {12.5, 2}}};
+
+    for (Geometry::FillRule rule : {Geometry::FillRule::EVEN_ODD, Geometry::FillRule::NONZERO}) {
+        // A hole given against the shell: both rules cut it out.
+        same_as_definition({outer, hole}, rule);
+        // An inner ring given along the shell: a hole for even-odd, filled for nonzero.
+        same_as_definition({outer, same}, rule);
+        // Three levels of nesting, and a shell touching nothing.
+        same_as_definition({outer, hole, island, apart}, rule);
+        same_as_definition({island, outer, same}, rule);
+    }
+    return Check::result();
+}
@@ -0,0 +1,29 @@
+#include <sstream>
+#include <string>
+
+#include "check.h"
+#include "scanner.h"
+
+// Scanner results must match operator>> for every token.
+static void same_as_stream(const std::string &token) {
+    double expected = 0, actual = 0;
+    std::istringstream(token) >> expected;
+    IO::Scanner scanner(token.data(), token.data() + token.size());
+    scanner >> actual;
+    CHECK(scanner);
+    CHECK(actual == expected);
+}
+
+int main() {
+    same_as_stream("0");
+    same_as_stream("-12.5");
+    same_as_stream("1e22");
+    same_as_stream("123456789012345678901234567890");
+
+    // Longer than any fixed buffer: the digits past 127 still decide the rounding.
+    std::string halfway = "9007199254740993";
+    same_as_stream(halfway + std::string(150, '0') + "1e-150");
+    same_as_stream("0." + std::string(200, '0') + "17976931348623157");
+    same_as_stream("1." + std::string(300, '9'));
+    return Check::result();
+}
@@ -0,0 +1,168 @@
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include "binary_format.h"
+#include "geometry.h"
+#include "scanner.h"
+
+// Converts test and answer files between the text format read and written by
+// geom and the binary formats described in binary_format.h. Reads standard
+// input, writes standard output.
+
+namespace {
+    template <class C>
+    bool read_points(IO::Scanner &is, std::vector<Geometry::Point<C>> &points) {
+        size_t n = 0;
+        is >> n;
+        points.clear();
+        for (size_t i = 0; i < n && is; ++i) {
+            Geometry::Point<C> p;
+            is >> p;
+            p.setId(i);
+            points.push_back(p);
+        }
+        return static_cast<bool>(is);
+    }
+
+    template <class C>
+    int tests_to_binary(const IO::InputBuffer &input, IO::Binary::Coordinates coordinates) {
+        IO::Scanner is(input.begin(), input.end());
+        uint64_t tests = 0;
+        is >> tests;
+        if (!is) {
+            std::cerr << "geom_convert: cannot read the test count\n";
+            return 1;
+        }
+
+        IO::BinaryWriter writer(std::cout, coordinates, tests);
+        std::vector<Geometry::Point<C>> points;
+        for (uint64_t t = 0; t < tests; ++t) {
+            for (int set = 0; set < 2; ++set) {
+                if (!read_points(is, points)) {
+                    std::cerr << "geom_convert: truncated test " << t << '\n';
+                    return 1;
+                }
+                writer.write(points);
+            }
+        }
+        return 0;
+    }
+
+    template <class C>
+    int tests_to_text(IO::BinaryReader &is) {
+        std::cout.precision(std::numeric_limits<C>::max_digits10);
+
+        uint64_t tests = 0;
+        is >> tests;
+        std::cout << tests << '\n';
+
+        std::vector<Geometry::Point<C>> points;
+        for (uint64_t t = 0; t < tests && is; ++t) {
+            for (int set = 0; set < 2; ++set) {
+                size_t n = 0;
+                is >> n;
+                is.read<Geometry::Point<C>>(n, points);
+                std::cout << points.size() << '\n';
+                for (const Geometry::Point<C> &p : points)
+                    std::cout << p << '\n';
+            }
+        }
+
+        if (!is) {
+            std::cerr << "geom_convert: truncated binary test file\n";
+            return 1;
+        }
+        return 0;
+    }
+
+    int answers_to_binary(const IO::InputBuffer &input) {
+        // Text answers carry no test boundaries, so they become a single record.
+        std::vector<Geometry::State> answers;
+        const char *cur = input.begin(), *end = input.end();
+        while (cur != end) {
+            const char *line = cur;
+            while (cur != end && *cur != '\n')
+                ++cur;
+            std::string word(line, cur);
+            if (cur != end)
+                ++cur;
+
+            if (word == "INSIDE") {
+                answers.push_back(Geometry::State::INSIDE);
+            } else if (word == "OUTSIDE") {
+                answers.push_back(Geometry::State::OUTSIDE);
+            } else if (word == "BORDER") {
+                answers.push_back(Geometry::State::BORDER);
+            } else if (!word.empty()) {
+                std::cerr << "geom_convert: unknown answer '" << word << "'\n";
+                return 1;
+            }
+        }
+
+        IO::AnswerWriter writer(std::cout);
+        writer.write(answers);
+        return 0;
+    }
+
+    int answers_to_text(const IO::InputBuffer &input) {
+        static const char *names[] = {"OUTSIDE", "INSIDE", "BORDER"};
+
+        IO::AnswerReader is(input.begin(), input.end());
+        std::vector<Geometry::State> answers;
+        while (is.read(answers)) {
+            for (Geometry::State state : answers)
+                std::cout << names[state] << '\n';
+        }
+
+        if (is.failed()) {
+            std::cerr << "geom_convert: not a binary answer file or truncated\n";
+            return 1;
+        }
+        return 0;
+    }
+}
+
+int main(int argc, char **argv) {
+    std::string command = (argc >= 2 ? argv[1] : "");
+    std::string coordinates = (argc >= 3 ? argv[2] : "double");
+    std::ios::sync_with_stdio(false);
+
+    if (command == "tests-to-binary" && (coordinates == "double" || coordinates == "int")) {
+        IO::InputBuffer input(STDIN_FILENO);
+        if (coordinates == "int")
+            return tests_to_binary<int64_t>(input, IO::Binary::INT64);
+        return tests_to_binary<double>(input, IO::Binary::FLOAT64);
+    }
+    if (command == "tests-to-text") {
+        IO::InputBuffer input(STDIN_FILENO);
+        IO::BinaryReader reader(input.begin(), input.end());
+        if (!reader) {
+            std::cerr << "geom_convert: not a binary test file\n";
+            return 1;
+        }
+        if (reader.coordinates() == IO::Binary::INT64)
+            return tests_to_text<int64_t>(reader);
+        return tests_to_text<double>(reader);
+    }
+    if (command == "answers-to-binary") {
+        IO::InputBuffer input(STDIN_FILENO);
+        return answers_to_binary(input);
+    }
+    if (command == "answers-to-text") {
+        IO::InputBuffer input(STDIN_FILENO);
+        return answers_to_text(input);
+    }
+
+    std::cerr << "usage:\n"
+              << "  geom_convert tests-to-binary [double|int] < tests.txt > tests.bin\n"
+              << "  geom_convert tests-to-text < tests.bin > tests.txt\n"
+              << "  geom_convert answers-to-binary < answers.txt > answers.bin\n"
+              << "  geom_convert answers-to-text < answers.bin > answers.txt\n";
+    return 1;
+}